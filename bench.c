@@ -0,0 +1,273 @@
+/**
+* @file: bench.c
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file contains the benchmark of the simulation engines
+* Every engine is timed over a matrix of board sizes and initial densities,
+* and the results are printed as CSV or JSON
+**/
+
+/** Head files **/
+#define _POSIX_C_SOURCE 200809L
+#include <time.h>
+#include <sys/resource.h>
+#include "src/board.h"
+#include "src/engine.h"
+
+/** Benchmark parameters **/
+#define MAX_CASES 16            // The maximum number of sizes, densities or engines in a list
+#define MIN_SECONDS 0.25        // The minimum time spent on each case
+#define HASHLIFE_DEFAULT_SIZE 4096  // The largest board HashLife is timed on when the engines are not given, a random soup leaves it nothing to reuse
+#define USAGE "Usage: ./build/debug/bench [--format csv|json] [--sizes 64,256,...] [--densities 0.1,0.3,...]\n" \
+    "       [--engines reference,bitboard,...] [--threads <n>] [--min-time <seconds>] [--rule <B3/S23>]\n" \
+    "       [--boundary <dead|torus|klein>]\n"
+
+
+/* Get the time in seconds from a monotonic clock
+    *
+    * @return: the time in seconds
+*/
+static double now_in_seconds( void )
+{
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* Get the peak resident set size of the process
+    *
+    * @return: the peak resident set size in kilobytes
+*/
+static long peak_rss_kb( void )
+{
+    FILE *status = fopen( "/proc/self/status", "r" );
+    if ( status != NULL )
+    {
+        char line[128];
+        long kb = -1;
+        while ( fgets( line, sizeof( line ), status ) != NULL )
+        {
+            if ( sscanf( line, "VmHWM: %ld kB", &kb ) == 1 )
+                break;
+        }
+        fclose( status );
+        if ( kb >= 0 )
+            return kb;
+    }
+    // Fall back to getrusage. Only Linux resets the peak for each case, elsewhere it is the peak of the whole run so far
+    struct rusage usage;
+    getrusage( RUSAGE_SELF, &usage );
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;     // macOS gives it in bytes
+#else
+    return usage.ru_maxrss;
+#endif
+}
+
+/* Reset the peak resident set size so that every case reports its own peak (Linux only)
+    *
+    * @return: none
+*/
+static void reset_peak_rss( void )
+{
+    FILE *refs = fopen( "/proc/self/clear_refs", "w" );
+    if ( refs == NULL )
+        return;
+    fputs( "5", refs );
+    fclose( refs );
+}
+
+/* Parse a comma separated list of numbers
+    *
+    * @param text: the list
+    * @param values: the parsed numbers
+    *
+    * @return: the number of values, 0 if the list is invalid
+*/
+static int parse_list( char *text, double *values )
+{
+    int count = 0;
+    for ( char *item = strtok( text, "," ); item != NULL && count < MAX_CASES; item = strtok( NULL, "," ) )
+    {
+        char *end;
+        values[count] = strtod( item, &end );
+        if ( *end != '\0' || values[count] <= 0 )
+            return 0;
+        count++;
+    }
+    return count;
+}
+
+/* Fill a board with random cells
+    *
+    * @param board: the allocated board
+    * @param density: the probability of a cell to be alive
+    *
+    * @return: none
+*/
+static void fill_random( Board *board, double density )
+{
+    unsigned int threshold = ( unsigned int )( density * 65536 );
+    unsigned long long state = 0x9E3779B97F4A7C15ULL;
+    for ( int i = 0; i < board->rows; i++ )
+    {
+        for ( int j = 0; j < board->columns; j++ )
+        {
+            // xorshift keeps the boards identical between runs and platforms
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            board->grid[i][j] = ( state & 0xFFFF ) < threshold;
+        }
+    }
+}
+
+int main( int argc, char** argv )
+{
+    // Read command line arguments
+    double sizes[MAX_CASES] = { 64, 256, 1024, 4096, 16384 };
+    double densities[MAX_CASES] = { 0.05, 0.3, 0.5 };
+    int engines[MAX_CASES];
+    int size_count = 5, density_count = 3, engine_count = 0, json = 0;
+    long threads = 1;
+    double min_seconds = MIN_SECONDS;
+    uint32_t rule = RULE_CONWAY;
+    int boundary = BOUNDARY_DEAD;
+    int default_engines = 1;    // 1 while every engine is timed because --engines was not given
+    for ( int i = 0; i < ENGINE_COUNT; i++ )
+        engines[engine_count++] = i;
+    for ( int i = 1; i + 1 < argc; i += 2 )
+    {
+        if ( strcmp( argv[i], "--format" ) == 0 )
+            json = strcmp( argv[i + 1], "json" ) == 0;
+        else if ( strcmp( argv[i], "--sizes" ) == 0 )
+            size_count = parse_list( argv[i + 1], sizes );
+        else if ( strcmp( argv[i], "--densities" ) == 0 )
+            density_count = parse_list( argv[i + 1], densities );
+        else if ( strcmp( argv[i], "--threads" ) == 0 )
+            threads = strtol( argv[i + 1], NULL, 10 );
+        else if ( strcmp( argv[i], "--min-time" ) == 0 )
+            min_seconds = strtod( argv[i + 1], NULL );
+        else if ( strcmp( argv[i], "--rule" ) == 0 )
+        {
+            if ( parse_rule( argv[i + 1], &rule ) == EXIT_FAILURE )
+                return EXIT_FAILURE;
+        }
+        else if ( strcmp( argv[i], "--boundary" ) == 0 )
+        {
+            boundary = parse_boundary_mode( argv[i + 1] );
+            if ( boundary < 0 )
+            {
+                fprintf( stderr, "[Err] The boundary has to be dead, torus or klein: %s\n", argv[i + 1] );
+                return EXIT_FAILURE;
+            }
+        }
+        else if ( strcmp( argv[i], "--engines" ) == 0 )
+        {
+            engine_count = 0;
+            default_engines = 0;
+            for ( char *name = strtok( argv[i + 1], "," ); name != NULL && engine_count < MAX_CASES; name = strtok( NULL, "," ) )
+            {
+                engines[engine_count] = parse_engine_type( name );
+                if ( engines[engine_count] < 0 )
+                {
+                    fprintf( stderr, "[Err] Unknown engine: %s\n", name );
+                    return EXIT_FAILURE;
+                }
+                engine_count++;
+            }
+        }
+        else
+        {
+            fprintf( stderr, "[Err] Unknown option: %s\n%s", argv[i], USAGE );
+            return EXIT_FAILURE;
+        }
+    }
+    if ( argc % 2 == 0 || size_count == 0 || density_count == 0 || engine_count == 0 || threads < 1 || min_seconds < 0 )
+    {
+        fprintf( stderr, USAGE );
+        return EXIT_FAILURE;
+    }
+
+    // Run every case of the matrix
+    if ( json )
+        printf( "[\n" );
+    else
+        printf( "engine,threads,rows,columns,density,generations,seconds,cells_per_sec,ns_per_cell,peak_rss_kb\n" );
+    int first = 1;
+    int failed = 0;         // 1 if an engine failed, the case is then left out
+    for ( int s = 0; s < size_count; s++ )
+    {
+        for ( int d = 0; d < density_count; d++ )
+        {
+            for ( int e = 0; e < engine_count; e++ )
+            {
+                // One generation of a large random soup takes HashLife minutes, it is only timed there when asked for
+                if ( default_engines && engines[e] == ENGINE_HASHLIFE && sizes[s] > HASHLIFE_DEFAULT_SIZE )
+                    continue;
+                reset_peak_rss();
+                Board board;
+                memset( &board, 0, sizeof( Board ) );
+                board.rows = board.columns = ( int )sizes[s];
+                board.rule = rule;
+                board.boundary = ( BoundaryMode )boundary;
+                if ( alloc_board( &board ) == EXIT_FAILURE )
+                    continue;
+                fill_random( &board, densities[d] );
+                Engine engine;
+                if ( init_engine( &engine, engines[e], ( int )threads, &board ) == EXIT_FAILURE )
+                {
+                    free_board( &board );
+                    continue;
+                }
+                // Keep stepping until the case has run for long enough
+                long generations = 0;
+                int code = EXIT_SUCCESS;
+                double start = now_in_seconds(), elapsed = 0;
+                do
+                {
+                    code = step_engine( &engine, 1 );
+                    generations++;
+                    elapsed = now_in_seconds() - start;
+                } while ( code == EXIT_SUCCESS && elapsed < min_seconds );
+                long rss = peak_rss_kb();
+                free_engine( &engine );
+                free_board( &board );
+                // A failed engine is not timed as if it had run
+                if ( code == EXIT_FAILURE )
+                {
+                    fprintf( stderr, "[Err] The %s engine failed at generation %ld of the %d x %d board with density %g\n",
+                        get_engine_name( engines[e] ), generations, board.rows, board.columns, densities[d] );
+                    failed = 1;
+                    continue;
+                }
+
+                double cells = ( double )board.rows * board.columns * generations;
+                const char *format = json
+                    ? "%s  {\"engine\": \"%s\", \"threads\": %ld, \"rows\": %d, \"columns\": %d, \"density\": %g, "
+                      "\"generations\": %ld, \"seconds\": %.6f, \"cells_per_sec\": %.6e, \"ns_per_cell\": %.4f, \"peak_rss_kb\": %ld}"
+                    : "%s%s,%ld,%d,%d,%g,%ld,%.6f,%.6e,%.4f,%ld\n";
+                printf( format, json && !first ? ",\n" : "", get_engine_name( engines[e] ), threads, board.rows, board.columns,
+                    densities[d], generations, elapsed, cells / elapsed, elapsed * 1e9 / cells, rss );
+                fflush( stdout );
+                first = 0;
+            }
+        }
+    }
+    if ( json )
+        printf( "\n]\n" );
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,132 @@
+/**
+* @file: assets.c
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file contains all the functions of the image cache
+* All the according function prototypes are defined in assets.h
+**/
+
+/** Head files **/
+#define _POSIX_C_SOURCE 200809L
+#include <dirent.h>
+#include "assets.h"
+
+
+/* Check whether a file name has the extension of an image SDL_image can read */
+static int is_image( const char *name )
+{
+    static const char *extensions[] = { ".png", ".svg", ".jpg", ".jpeg", ".bmp" };
+    const char *dot = strrchr( name, '.' );
+    if ( dot == NULL )
+        return 0;
+    for ( size_t i = 0; i < sizeof( extensions ) / sizeof( extensions[0] ); i++ )
+    {
+        if ( strcmp( dot, extensions[i] ) == 0 )
+            return 1;
+    }
+    return 0;
+}
+
+/* Read an image from the disk and upload it as a texture
+   An image that cannot be loaded is kept without a texture, so it is not read again every frame */
+static int load_asset( AssetCache *cache, const char *name )
+{
+    if ( cache->count == MAX_ASSETS || strlen( name ) >= MAX_ASSET_NAME )
+    {
+        fprintf( stderr, "[Err] Unable to cache image %s\n", name );
+        return -1;
+    }
+    Asset *asset = &cache->assets[cache->count++];
+    memset( asset, 0, sizeof( Asset ) );
+    snprintf( asset->name, MAX_ASSET_NAME, "%s", name );
+    char path[512];
+    snprintf( path, sizeof( path ), "%s/%s", cache->directory, name );
+    SDL_Surface *surface = IMG_Load( path );
+    cache->disk_loads++;
+    if ( surface == NULL )
+    {
+        fprintf( stderr, "[Err] Unable to load image %s! SDL_image Error: %s\n", path, IMG_GetError() );
+        return -1;
+    }
+    asset->texture = SDL_CreateTextureFromSurface( cache->rend, surface );
+    asset->width = surface->w;
+    asset->height = surface->h;
+    SDL_FreeSurface( surface );
+    if ( asset->texture == NULL )
+    {
+        fprintf( stderr, "[Err] Unable to create the texture of image %s, SDL_Error: %s\n", path, SDL_GetError() );
+        return -1;
+    }
+    return cache->count - 1;
+}
+
+int init_asset_cache( AssetCache *cache, SDL_Renderer *rend, const char *directory )
+{
+    if ( cache == NULL || rend == NULL || directory == NULL )
+        return EXIT_FAILURE;
+    memset( cache, 0, sizeof( AssetCache ) );
+    cache->rend = rend;
+    snprintf( cache->directory, sizeof( cache->directory ), "%s", directory );
+    DIR *dir = opendir( directory );
+    if ( dir == NULL )
+    {
+        fprintf( stderr, "[Err] Unable to open the image directory %s\n", directory );
+        return EXIT_FAILURE;
+    }
+    // An image that fails to load is reported and skipped, the others are still usable
+    struct dirent *entry;
+    while ( ( entry = readdir( dir ) ) != NULL )
+    {
+        if ( entry->d_name[0] != '.' && is_image( entry->d_name ) )
+            load_asset( cache, entry->d_name );
+    }
+    closedir( dir );
+    return EXIT_SUCCESS;
+}
+
+void free_asset_cache( AssetCache *cache )
+{
+    if ( cache == NULL )
+        return;
+    for ( int i = 0; i < cache->count; i++ )
+    {
+        if ( cache->assets[i].texture != NULL )
+            SDL_DestroyTexture( cache->assets[i].texture );
+        cache->assets[i].texture = NULL;
+    }
+    cache->count = 0;
+}
+
+int get_asset( AssetCache *cache, const char *name )
+{
+    if ( cache == NULL || name == NULL )
+        return -1;
+    for ( int i = 0; i < cache->count; i++ )
+    {
+        if ( strcmp( cache->assets[i].name, name ) == 0 )
+            return cache->assets[i].texture != NULL ? i : -1;
+    }
+    return load_asset( cache, name );
+}
+
+int draw_asset( AssetCache *cache, int handle, int x, int y, int w, int h )
+{
+    if ( cache == NULL || handle < 0 || handle >= cache->count || cache->assets[handle].texture == NULL )
+        return EXIT_FAILURE;
+    SDL_Rect rect = { x, y, w, h };
+    SDL_RenderCopy( cache->rend, cache->assets[handle].texture, NULL, &rect );
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,99 @@
+/**
+* @file: assets.h
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file contains the function prototypes of the image cache
+* Every image of the resource directory is loaded and uploaded to the GPU once, drawing
+* an image afterwards only copies the resident texture by its handle
+**/
+
+
+#ifndef ASSETS_H
+#define ASSETS_H
+
+
+/** Include all the libraries **/
+#include "game.h"
+
+
+/** Define all the marcos of the image cache **/
+#define ASSET_DIRECTORY "resources/images"  // The directory that is preloaded
+#define MAX_ASSETS 32                       // The number of images the cache can hold
+#define MAX_ASSET_NAME 64                   // The maximum length of an image file name, including the terminator
+
+
+/** define all the structs used in the image cache **/
+typedef struct
+{
+    char name[MAX_ASSET_NAME];      // The file name of the image
+    SDL_Texture *texture;           // The resident texture of the image
+    int width;                      // The width of the image
+    int height;                     // The height of the image
+} Asset;
+
+typedef struct
+{
+    SDL_Renderer *rend;             // The renderer that owns the textures
+    char directory[256];            // The directory the images are loaded from
+    Asset assets[MAX_ASSETS];       // The loaded images
+    int count;                      // The number of loaded images
+    size_t disk_loads;              // The number of images read from the disk, it stays constant in steady state
+} AssetCache;
+
+
+/** Declare all the function prototypes **/
+/* Load every image of a directory into the cache
+    *
+    * @param cache: the cache to be initialized
+    * @param rend: the renderer that owns the textures
+    * @param directory: the directory of the images
+    *
+    * @return: EXIT_SUCCESS if the directory is read successfully, EXIT_FAILURE otherwise
+*/
+int init_asset_cache( AssetCache *cache, SDL_Renderer *rend, const char *directory );
+
+/* Destroy every texture of the cache
+    *
+    * @param cache: the cache to be freed
+    *
+    * @return: none
+*/
+void free_asset_cache( AssetCache *cache );
+
+/* Get the handle of an image, the image is loaded on the first use if it was not preloaded
+    *
+    * @param cache: the cache
+    * @param name: the file name of the image in the directory of the cache
+    *
+    * @return: the handle of the image, -1 if it cannot be loaded
+*/
+int get_asset( AssetCache *cache, const char *name );
+
+/* Draw an image of the cache
+    *
+    * @param cache: the cache
+    * @param handle: the handle of the image
+    * @param x: the x coordinate of the image
+    * @param y: the y coordinate of the image
+    * @param w: the width of the image on the screen
+    * @param h: the height of the image on the screen
+    *
+    * @return: EXIT_SUCCESS if the image is drawn successfully, EXIT_FAILURE otherwise
+*/
+int draw_asset( AssetCache *cache, int handle, int x, int y, int w, int h );
+
+
+#endif
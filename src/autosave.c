@@ -0,0 +1,165 @@
+/**
+* @file: autosave.c
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file contains all the functions of the autosave
+* All the according function prototypes are defined in autosave.h
+**/
+
+/** Head files **/
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "autosave.h"
+#include "binfile.h"
+#include "pattern.h"
+
+
+/* Get the temporary name of a file, it has to be freed */
+static char *temporary_name( const char *file )
+{
+    char *name = ( char* )malloc( strlen( file ) + strlen( AUTOSAVE_SUFFIX ) + 1 );
+    if ( name != NULL )
+        sprintf( name, "%s%s", file, AUTOSAVE_SUFFIX );
+    return name;
+}
+
+/* Move a completely written temporary file over the real one, or remove it if the write failed */
+static int replace_file( char *temporary, const char *file, int code )
+{
+    if ( code == EXIT_SUCCESS && rename( temporary, file ) != 0 )
+    {
+        fprintf( stderr, "[Err] %s could not be replaced\n", file );
+        code = EXIT_FAILURE;
+    }
+    if ( code == EXIT_FAILURE )
+        remove( temporary );
+    free( temporary );
+    return code;
+}
+
+/* The loop of the writer thread, it writes every copy handed to it until the autosave is stopped */
+static void *run_autosave( void *arg )
+{
+    AutoSave *autosave = arg;
+    pthread_mutex_lock( &autosave->lock );
+    for ( ;; )
+    {
+        while ( !autosave->pending && !autosave->quit )
+            pthread_cond_wait( &autosave->wake, &autosave->lock );
+        if ( !autosave->pending )
+            break;
+        // The copy is owned by this thread until pending is cleared, so it is written without the lock
+        pthread_mutex_unlock( &autosave->lock );
+        int code = save_board_file( autosave->config_file, autosave->data_file, &autosave->board, autosave->generation );
+        pthread_mutex_lock( &autosave->lock );
+        if ( code == EXIT_SUCCESS )
+            autosave->saves++;
+        else
+            autosave->failures++;
+        autosave->pending = 0;
+        pthread_cond_broadcast( &autosave->wake );
+    }
+    pthread_mutex_unlock( &autosave->lock );
+    return NULL;
+}
+
+
+int save_board_file( char *config_file, char *data_file, Board *board, uint64_t generation )
+{
+    if ( data_file == NULL || board == NULL || board->grid == NULL )
+        return EXIT_FAILURE;
+    char *data = temporary_name( data_file );
+    if ( data == NULL )
+        return EXIT_FAILURE;
+    int code;
+    if ( is_bin_file( data_file ) )
+        return replace_file( data, data_file, write_board_to_bin( data, board, generation ) );
+    if ( get_pattern_format( data_file ) != PATTERN_NONE )
+        code = write_pattern_file( data, board );
+    else
+        code = write_data_file( data, board );
+    // The configuration is replaced after the data, a crash in between leaves the old size with the old cells
+    if ( replace_file( data, data_file, code ) == EXIT_FAILURE || config_file == NULL )
+        return EXIT_FAILURE;
+    char *config = temporary_name( config_file );
+    if ( config == NULL )
+        return EXIT_FAILURE;
+    return replace_file( config, config_file, write_config_file( config, board ) );
+}
+
+int start_autosave( AutoSave *autosave, char *config_file, char *data_file, Board *board )
+{
+    if ( autosave == NULL || data_file == NULL || board == NULL )
+        return EXIT_FAILURE;
+    memset( autosave, 0, sizeof( AutoSave ) );
+    autosave->config_file = config_file;
+    autosave->data_file = data_file;
+    autosave->board.rows = board->rows;
+    autosave->board.columns = board->columns;
+    autosave->board.delay = board->delay;
+    autosave->board.rule = board->rule;
+    autosave->board.boundary = board->boundary;
+    if ( alloc_board( &autosave->board ) == EXIT_FAILURE )
+        return EXIT_FAILURE;
+    pthread_mutex_init( &autosave->lock, NULL );
+    pthread_cond_init( &autosave->wake, NULL );
+    if ( pthread_create( &autosave->thread, NULL, run_autosave, autosave ) != 0 )
+    {
+        fprintf( stderr, "[Err] The autosave thread could not be created\n" );
+        pthread_mutex_destroy( &autosave->lock );
+        pthread_cond_destroy( &autosave->wake );
+        free_board( &autosave->board );
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+int request_autosave( AutoSave *autosave, Board *board, uint64_t generation )
+{
+    pthread_mutex_lock( &autosave->lock );
+    int busy = autosave->pending;
+    if ( busy )
+        autosave->skipped++;
+    pthread_mutex_unlock( &autosave->lock );
+    if ( busy || board->rows != autosave->board.rows || board->columns != autosave->board.columns )
+        return EXIT_FAILURE;
+    // The writer is idle, so the copy can be filled without the lock
+    for ( int i = 0; i < board->rows; i++ )
+        memcpy( autosave->board.grid[i], board->grid[i], board->columns );
+    autosave->board.delay = board->delay;
+    autosave->generation = generation;
+    pthread_mutex_lock( &autosave->lock );
+    autosave->pending = 1;
+    pthread_cond_broadcast( &autosave->wake );
+    pthread_mutex_unlock( &autosave->lock );
+    return EXIT_SUCCESS;
+}
+
+void stop_autosave( AutoSave *autosave )
+{
+    if ( autosave == NULL || autosave->board.grid == NULL )
+        return;
+    pthread_mutex_lock( &autosave->lock );
+    autosave->quit = 1;
+    pthread_cond_broadcast( &autosave->wake );
+    pthread_mutex_unlock( &autosave->lock );
+    pthread_join( autosave->thread, NULL );
+    pthread_mutex_destroy( &autosave->lock );
+    pthread_cond_destroy( &autosave->wake );
+    free_board( &autosave->board );
+}
@@ -0,0 +1,103 @@
+/**
+* @file: autosave.h
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file contains the function prototypes of the autosave
+* The board is copied into a buffer owned by a writer thread, which saves it in the
+* background while the game goes on. Every save is written to a temporary file that
+* is then renamed over the old one, so a crash never leaves a half written board.
+**/
+
+
+#ifndef AUTOSAVE_H
+#define AUTOSAVE_H
+
+
+/** Include all the libraries **/
+#include <stdint.h>
+#include <pthread.h>
+#include "board.h"
+
+
+/** Define all the marcos of the autosave **/
+#define AUTOSAVE_SUFFIX ".tmp"          // Added to the name of a file while it is written
+#define AUTOSAVE_DEFAULT_SECONDS 30     // The default time between two autosaves
+
+
+/** define all the structs used by the autosave **/
+typedef struct
+{
+    char *config_file;          // The configuration file saved to, not owned
+    char *data_file;            // The data file saved to, its extension gives the format, not owned
+    Board board;                // The copy of the board written by the writer thread
+    uint64_t generation;        // The generation of the copy
+    pthread_t thread;           // The writer thread
+    pthread_mutex_t lock;       // The lock protecting everything below
+    pthread_cond_t wake;        // Signalled when a copy is ready or the writer has to quit
+    int pending;                // 1 while the copy is waiting to be written or being written
+    int quit;                   // Set to stop the writer thread
+    size_t saves;               // The number of copies written successfully
+    size_t failures;            // The number of copies that could not be written
+    size_t skipped;             // The number of requests dropped because the writer was busy
+} AutoSave;
+
+
+/** Declare all the function prototypes **/
+/* Save a board atomically in the format given by the extension of the data file
+    * A .bin file is a binary snapshot, a .rle or .lif file a pattern and anything else a text grid.
+    * Each file is written under a temporary name and renamed over the old one once complete.
+    *
+    * @param config_file: the name of the configuration file, not written for snapshots
+    * @param data_file: the name of the data file
+    * @param board: the board to be saved
+    * @param generation: the generation of the board
+    *
+    * @return: EXIT_SUCCESS if the board is saved successfully, EXIT_FAILURE otherwise
+*/
+int save_board_file( char *config_file, char *data_file, Board *board, uint64_t generation );
+
+/* Allocate the copy of a board and start the writer thread
+    *
+    * @param autosave: the autosave to be started
+    * @param config_file: the name of the configuration file, it has to stay valid
+    * @param data_file: the name of the data file, it has to stay valid
+    * @param board: the board that will be saved, only its size is used here
+    *
+    * @return: EXIT_SUCCESS if the writer is started successfully, EXIT_FAILURE otherwise
+*/
+int start_autosave( AutoSave *autosave, char *config_file, char *data_file, Board *board );
+
+/* Copy a board and hand it to the writer thread, it never waits for the disk
+    * The request is dropped if the previous copy is still being written
+    *
+    * @param autosave: the autosave
+    * @param board: the board to be saved, the same size as the one given to start_autosave
+    * @param generation: the generation of the board
+    *
+    * @return: EXIT_SUCCESS if the copy is handed over, EXIT_FAILURE if the writer was busy
+*/
+int request_autosave( AutoSave *autosave, Board *board, uint64_t generation );
+
+/* Wait for the copy being written, stop the writer thread and free the copy
+    *
+    * @param autosave: the autosave to be stopped
+    *
+    * @return: none
+*/
+void stop_autosave( AutoSave *autosave );
+
+
+#endif
@@ -0,0 +1,306 @@
+/**
+* @file: binfile.c
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file contains all the functions of the binary snapshot files
+* All the according function prototypes are defined in binfile.h
+**/
+
+/** Head files **/
+#define _POSIX_C_SOURCE 200809L
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "binfile.h"
+
+
+/** The checksum is a 64 bit FNV-1a over the words rather than the bytes **/
+#define BIN_CHECKSUM_SEED 0xcbf29ce484222325ull
+#define BIN_CHECKSUM_PRIME 0x100000001b3ull
+
+
+/* Add words to a running checksum */
+static uint64_t add_checksum( uint64_t hash, const uint64_t *words, size_t count )
+{
+    for ( size_t i = 0; i < count; i++ )
+        hash = ( hash ^ words[i] ) * BIN_CHECKSUM_PRIME;
+    return hash;
+}
+
+/* Fill the header of a snapshot */
+static void fill_header( BinHeader *header, int rows, int columns, int words_per_row, int delay, uint32_t rule,
+    BoundaryMode boundary, uint64_t generation )
+{
+    memset( header, 0, sizeof( BinHeader ) );
+    memcpy( header->magic, BIN_MAGIC, sizeof( BIN_MAGIC ) );
+    header->version = BIN_VERSION;
+    header->header_size = BIN_HEADER_SIZE;
+    header->rows = rows;
+    header->columns = columns;
+    header->words_per_row = words_per_row;
+    header->delay = delay;
+    header->rule = rule;
+    header->boundary = ( uint32_t )boundary;
+    header->generation = generation;
+    header->data_size = ( uint64_t )rows * words_per_row * sizeof( uint64_t );
+}
+
+/* Write the header padded to BIN_HEADER_SIZE, at the start of the file */
+static int write_header( FILE *fp, BinHeader *header )
+{
+    static const char padding[BIN_HEADER_SIZE];
+    if ( fseek( fp, 0, SEEK_SET ) != 0 || fwrite( header, sizeof( BinHeader ), 1, fp ) != 1 ||
+        fwrite( padding, BIN_HEADER_SIZE - sizeof( BinHeader ), 1, fp ) != 1 )
+        return EXIT_FAILURE;
+    return EXIT_SUCCESS;
+}
+
+/* Pack a row of cells into words, 8 cells are gathered into a byte with one multiplication */
+static void pack_row( const Cell *cells, int columns, uint64_t *words, int words_per_row )
+{
+    memset( words, 0, ( size_t )words_per_row * sizeof( uint64_t ) );
+    int j = 0;
+    for ( ; j + 8 <= columns; j += 8 )
+    {
+        uint64_t bytes;
+        memcpy( &bytes, cells + j, sizeof( bytes ) );
+        words[j / CELLS_PER_WORD] |= ( ( bytes * 0x0102040810204080ull ) >> 56 ) << ( j % CELLS_PER_WORD );
+    }
+    for ( ; j < columns; j++ )
+        words[j / CELLS_PER_WORD] |= ( uint64_t )( cells[j] != 0 ) << ( j % CELLS_PER_WORD );
+}
+
+/* Unpack a row of words into cells, every byte of the words is spread over 8 cells with a table */
+static void unpack_row( const uint64_t *words, Cell *cells, int columns )
+{
+    static uint64_t spread[256];
+    if ( spread[255] == 0 )
+    {
+        for ( int b = 0; b < 256; b++ )
+            for ( int k = 0; k < 8; k++ )
+                spread[b] |= ( uint64_t )( ( b >> k ) & 1 ) << ( 8 * k );
+    }
+    int j = 0;
+    for ( ; j + 8 <= columns; j += 8 )
+        memcpy( cells + j, &spread[( words[j / CELLS_PER_WORD] >> ( j % CELLS_PER_WORD ) ) & 0xff], 8 );
+    for ( ; j < columns; j++ )
+        cells[j] = ( Cell )( ( words[j / CELLS_PER_WORD] >> ( j % CELLS_PER_WORD ) ) & 1 );
+}
+
+
+int is_bin_file( const char *file )
+{
+    if ( file == NULL )
+        return 0;
+    size_t length = strlen( file ), extension = strlen( BIN_EXTENSION );
+    return length > extension && strcmp( file + length - extension, BIN_EXTENSION ) == 0;
+}
+
+uint64_t get_bin_checksum( const uint64_t *words, size_t count )
+{
+    return add_checksum( BIN_CHECKSUM_SEED, words, count );
+}
+
+int open_bin_file( const char *file, BinFile *bin )
+{
+    if ( file == NULL || bin == NULL )
+        return EXIT_FAILURE;
+    memset( bin, 0, sizeof( BinFile ) );
+    int fd = open( file, O_RDONLY );
+    if ( fd < 0 )
+    {
+        fprintf( stderr, File_IO_Err );
+        return EXIT_FAILURE;
+    }
+    struct stat st;
+    if ( fstat( fd, &st ) != 0 || st.st_size < BIN_V1_HEADER_SIZE )
+    {
+        fprintf( stderr, "[Err] %s is not a snapshot file\n", file );
+        close( fd );
+        return EXIT_FAILURE;
+    }
+    // The pages are only read from the disk when the cells are touched
+    void *mapping = mmap( NULL, ( size_t )st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+    close( fd );
+    if ( mapping == MAP_FAILED )
+    {
+        fprintf( stderr, "[Err] %s could not be mapped into memory\n", file );
+        return EXIT_FAILURE;
+    }
+    bin->mapping = mapping;
+    bin->size = ( size_t )st.st_size;
+    bin->header = ( const BinHeader* )mapping;
+    const BinHeader *header = bin->header;
+    // Version 1 only differs by its 4 KiB header, its boundary field was reserved and written as 0, dead edges
+    if ( memcmp( header->magic, BIN_MAGIC, sizeof( BIN_MAGIC ) ) != 0 ||
+        !( ( header->version == BIN_VERSION && header->header_size == BIN_HEADER_SIZE ) ||
+        ( header->version == 1 && header->header_size == BIN_V1_HEADER_SIZE ) ) ||
+        header->header_size > bin->size )
+    {
+        fprintf( stderr, "[Err] %s is not a version 1 or %d snapshot file\n", file, BIN_VERSION );
+        close_bin_file( bin );
+        return EXIT_FAILURE;
+    }
+    if ( header->rows <= 0 || header->columns <= 0 ||
+        header->words_per_row != ( header->columns + CELLS_PER_WORD - 1 ) / CELLS_PER_WORD ||
+        header->data_size != ( uint64_t )header->rows * header->words_per_row * sizeof( uint64_t ) ||
+        header->data_size > bin->size - header->header_size )
+    {
+        fprintf( stderr, "[Err] The size of %s does not match its header\n", file );
+        close_bin_file( bin );
+        return EXIT_FAILURE;
+    }
+    if ( ( header->rule & ~RULE_MASK ) != 0 || ( header->rule & RULE_BIRTH( 0 ) ) != 0 )
+    {
+        fprintf( stderr, "[Err] The rule of %s is not supported\n", file );
+        close_bin_file( bin );
+        return EXIT_FAILURE;
+    }
+    if ( header->boundary >= BOUNDARY_COUNT )
+    {
+        fprintf( stderr, "[Err] The boundary of %s is not supported\n", file );
+        close_bin_file( bin );
+        return EXIT_FAILURE;
+    }
+    bin->words = ( const uint64_t* )( ( const char* )mapping + header->header_size );
+    if ( get_bin_checksum( bin->words, header->data_size / sizeof( uint64_t ) ) != header->checksum )
+    {
+        fprintf( stderr, "[Err] The checksum of %s does not match, the file is corrupted\n", file );
+        close_bin_file( bin );
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+void close_bin_file( BinFile *bin )
+{
+    if ( bin == NULL )
+        return;
+    if ( bin->mapping != NULL )
+        munmap( bin->mapping, bin->size );
+    memset( bin, 0, sizeof( BinFile ) );
+}
+
+int write_bitboard_to_bin( const char *file, BitBoard *bb, int delay, uint64_t generation )
+{
+    if ( file == NULL || bb == NULL || bb->cells == NULL )
+        return EXIT_FAILURE;
+    FILE *fp = fopen( file, "wb" );
+    if ( fp == NULL )
+    {
+        fprintf( stderr, File_IO_Err );
+        return EXIT_FAILURE;
+    }
+    BinHeader header;
+    size_t words = ( size_t )bb->rows * bb->words_per_row;
+    fill_header( &header, bb->rows, bb->columns, bb->words_per_row, delay, bb->rule, BOUNDARY_DEAD, generation );
+    header.checksum = get_bin_checksum( bb->cells, words );
+    // The words of the bit-packed board are the layout of the file, they are written in one call
+    int code = write_header( fp, &header );
+    if ( code == EXIT_SUCCESS && fwrite( bb->cells, sizeof( uint64_t ), words, fp ) != words )
+        code = EXIT_FAILURE;
+    if ( fclose( fp ) != 0 || code == EXIT_FAILURE )
+    {
+        fprintf( stderr, File_IO_Err );
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+int load_bitboard_from_bin( const char *file, BitBoard *bb, uint64_t *generation )
+{
+    if ( bb == NULL )
+        return EXIT_FAILURE;
+    BinFile bin;
+    if ( open_bin_file( file, &bin ) == EXIT_FAILURE )
+        return EXIT_FAILURE;
+    if ( init_bitboard( bb, bin.header->rows, bin.header->columns ) == EXIT_FAILURE )
+    {
+        close_bin_file( &bin );
+        return EXIT_FAILURE;
+    }
+    memcpy( bb->cells, bin.words, bin.header->data_size );
+    bb->rule = bin.header->rule;
+    if ( generation != NULL )
+        *generation = bin.header->generation;
+    close_bin_file( &bin );
+    return EXIT_SUCCESS;
+}
+
+int write_board_to_bin( const char *file, Board *board, uint64_t generation )
+{
+    if ( file == NULL || board == NULL || board->grid == NULL )
+        return EXIT_FAILURE;
+    int words_per_row = ( board->columns + CELLS_PER_WORD - 1 ) / CELLS_PER_WORD;
+    uint64_t *row = ( uint64_t* )malloc( ( size_t )words_per_row * sizeof( uint64_t ) );
+    FILE *fp = fopen( file, "wb" );
+    if ( row == NULL || fp == NULL )
+    {
+        fprintf( stderr, File_IO_Err );
+        free( row );
+        if ( fp != NULL )
+            fclose( fp );
+        return EXIT_FAILURE;
+    }
+    // The checksum is only known once every row is packed, so the header is written last
+    BinHeader header;
+    fill_header( &header, board->rows, board->columns, words_per_row, board->delay, board->rule, board->boundary, generation );
+    uint64_t checksum = BIN_CHECKSUM_SEED;
+    int code = write_header( fp, &header );
+    for ( int i = 0; i < board->rows && code == EXIT_SUCCESS; i++ )
+    {
+        pack_row( board->grid[i], board->columns, row, words_per_row );
+        checksum = add_checksum( checksum, row, words_per_row );
+        if ( fwrite( row, sizeof( uint64_t ), words_per_row, fp ) != ( size_t )words_per_row )
+            code = EXIT_FAILURE;
+    }
+    header.checksum = checksum;
+    if ( code == EXIT_SUCCESS )
+        code = write_header( fp, &header );
+    free( row );
+    if ( fclose( fp ) != 0 || code == EXIT_FAILURE )
+    {
+        fprintf( stderr, File_IO_Err );
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+int load_board_from_bin( const char *file, Board *board, uint64_t *generation )
+{
+    if ( board == NULL )
+        return EXIT_FAILURE;
+    BinFile bin;
+    if ( open_bin_file( file, &bin ) == EXIT_FAILURE )
+        return EXIT_FAILURE;
+    board->rows = bin.header->rows;
+    board->columns = bin.header->columns;
+    board->delay = bin.header->delay;
+    board->rule = bin.header->rule;
+    board->boundary = ( BoundaryMode )bin.header->boundary;
+    if ( alloc_board( board ) == EXIT_FAILURE )
+    {
+        close_bin_file( &bin );
+        return EXIT_FAILURE;
+    }
+    for ( int i = 0; i < board->rows; i++ )
+        unpack_row( bin.words + ( size_t )i * bin.header->words_per_row, board->grid[i], board->columns );
+    if ( generation != NULL )
+        *generation = bin.header->generation;
+    close_bin_file( &bin );
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,148 @@
+/**
+* @file: binfile.h
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file contains the function prototypes of the binary snapshot files
+* A snapshot is a header padded to 16 KiB, the largest common page size, with the size, rule, generation and checksum of the
+* board, followed by the cells in the layout of the bit-packed board, 64 cells per word.
+* The cells start on a page boundary, so a loaded file is mapped into memory and its
+* words are used as they are, nothing is parsed.
+**/
+
+
+#ifndef BINFILE_H
+#define BINFILE_H
+
+
+/** Include all the libraries **/
+#include <stdint.h>
+#include "board.h"
+#include "bitboard.h"
+
+
+/** Define all the marcos of the snapshot files **/
+#define BIN_MAGIC "GOLSNAP"         // The first 8 bytes of every snapshot, including the terminator
+#define BIN_VERSION 2               // The version of the layout written by this program
+#define BIN_HEADER_SIZE 16384       // The size of the header, the cells start on a page boundary with 4 and 16 KiB pages
+#define BIN_V1_HEADER_SIZE 4096     // The size of the header of the version 1 files, which are still read
+#define BIN_RULE_CONWAY RULE_CONWAY     // B3/S23, births in bits 0-8 and survivals in bits 9-17 as in rule.h
+#define BIN_EXTENSION ".bin"        // The extension of the snapshot files
+
+
+/** define all the structs used by the snapshot files **/
+typedef struct
+{
+    char magic[8];          // BIN_MAGIC
+    uint32_t version;       // BIN_VERSION
+    uint32_t header_size;   // The offset of the cells in the file
+    int32_t rows;           // The number of rows in the board
+    int32_t columns;        // The number of columns in the board
+    int32_t words_per_row;  // The number of words in each row of cells
+    int32_t delay;          // The delay between two frames
+    uint32_t rule;          // The rule the board was produced under
+    uint32_t boundary;      // The BoundaryMode of the board, reserved and always 0 in version 1, which is dead edges
+    uint64_t generation;    // The number of generations run before the snapshot was taken
+    uint64_t data_size;     // The number of bytes of cells after the header
+    uint64_t checksum;      // The checksum of the cells
+} BinHeader;
+
+typedef struct
+{
+    const BinHeader *header;    // The header at the start of the mapping
+    const uint64_t *words;      // The cells, row after row, words_per_row words each
+    void *mapping;              // The whole file mapped into memory
+    size_t size;                // The size of the mapping
+} BinFile;
+
+
+/** Declare all the function prototypes **/
+/* Check if a file name has the extension of a snapshot file
+    *
+    * @param file: the name of the file
+    *
+    * @return: 1 if the name ends with BIN_EXTENSION, 0 otherwise
+*/
+int is_bin_file( const char *file );
+
+/* Get the checksum of the cells of a snapshot
+    *
+    * @param words: the cells
+    * @param count: the number of words
+    *
+    * @return: the checksum
+*/
+uint64_t get_bin_checksum( const uint64_t *words, size_t count );
+
+/* Map a snapshot file into memory and check its header and checksum
+    *
+    * @param file: the name of the file
+    * @param bin: receives the mapping
+    *
+    * @return: EXIT_SUCCESS if the file is a valid snapshot, EXIT_FAILURE otherwise
+*/
+int open_bin_file( const char *file, BinFile *bin );
+
+/* Unmap a snapshot file
+    *
+    * @param bin: the mapping
+    *
+    * @return: none
+*/
+void close_bin_file( BinFile *bin );
+
+/* Write the cells of a bit-packed board to a snapshot file, the words are written as they are with dead edges
+    *
+    * @param file: the name of the file
+    * @param bb: the bit-packed board to be saved
+    * @param delay: the delay between two frames
+    * @param generation: the generation of the board
+    *
+    * @return: EXIT_SUCCESS if the file is saved successfully, EXIT_FAILURE otherwise
+*/
+int write_bitboard_to_bin( const char *file, BitBoard *bb, int delay, uint64_t generation );
+
+/* Initialize a bit-packed board with the cells of a snapshot file, they are copied from the mapping
+    *
+    * @param file: the name of the file
+    * @param bb: the bit-packed board to be initialized
+    * @param generation: receives the generation of the snapshot, can be NULL
+    *
+    * @return: EXIT_SUCCESS if the board is loaded successfully, EXIT_FAILURE otherwise
+*/
+int load_bitboard_from_bin( const char *file, BitBoard *bb, uint64_t *generation );
+
+/* Write the cells of a board to a snapshot file, they are packed one row at a time
+    *
+    * @param file: the name of the file
+    * @param board: the board to be saved
+    * @param generation: the generation of the board
+    *
+    * @return: EXIT_SUCCESS if the file is saved successfully, EXIT_FAILURE otherwise
+*/
+int write_board_to_bin( const char *file, Board *board, uint64_t generation );
+
+/* Initialize a board with the size, delay and cells of a snapshot file, the board is allocated here
+    *
+    * @param file: the name of the file
+    * @param board: the board to be initialized
+    * @param generation: receives the generation of the snapshot, can be NULL
+    *
+    * @return: EXIT_SUCCESS if the board is loaded successfully, EXIT_FAILURE otherwise
+*/
+int load_board_from_bin( const char *file, Board *board, uint64_t *generation );
+
+
+#endif
@@ -0,0 +1,236 @@
+/**
+* @file: bitboard.c
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file contains all the functions of the bit-packed board backend
+* All the according function prototypes are defined in bitboard.h
+**/
+
+/** Head files **/
+#include "bitboard.h"
+
+
+/* The mask of the columns that are in use in the last word of a row */
+static uint64_t last_word_mask( BitBoard *bb )
+{
+    int used = bb->columns % CELLS_PER_WORD;
+    return used == 0 ? ~( uint64_t )0 : ( ( uint64_t )1 << used ) - 1;
+}
+
+int init_bitboard( BitBoard *bb, int rows, int columns )
+{
+    if ( bb == NULL || rows <= 0 || columns <= 0 )
+        return EXIT_FAILURE;
+    bb->rows = rows;
+    bb->columns = columns;
+    bb->words_per_row = ( columns + CELLS_PER_WORD - 1 ) / CELLS_PER_WORD;
+    bb->rule = RULE_CONWAY;
+    // One zero row followed by the two generation buffers, all in one block
+    size_t words = ( size_t )rows * bb->words_per_row;
+    bb->memory = ( uint64_t* )calloc( 2 * words + bb->words_per_row, sizeof( uint64_t ) );
+    if ( bb->memory == NULL )
+    {
+        fprintf( stderr, "[Err] Unable to allocate a %d x %d bit-packed board\n", rows, columns );
+        return EXIT_FAILURE;
+    }
+    bb->zero_row = bb->memory;
+    bb->cells = bb->memory + bb->words_per_row;
+    bb->next = bb->cells + words;
+    return EXIT_SUCCESS;
+}
+
+void free_bitboard( BitBoard *bb )
+{
+    if ( bb == NULL )
+        return;
+    free( bb->memory );
+    bb->memory = bb->zero_row = bb->cells = bb->next = NULL;
+}
+
+int load_bitboard_from_board( BitBoard *bb, Board *board )
+{
+    if ( bb == NULL || board == NULL )
+        return EXIT_FAILURE;
+    if ( init_bitboard( bb, board->rows, board->columns ) == EXIT_FAILURE )
+        return EXIT_FAILURE;
+    bb->rule = board->rule;
+    for ( int i = 0; i < board->rows; i++ )
+    {
+        uint64_t *row = bb->cells + ( size_t )i * bb->words_per_row;
+        for ( int j = 0; j < board->columns; j++ )
+        {
+            if ( board->grid[i][j] )
+                row[j / CELLS_PER_WORD] |= ( uint64_t )1 << ( j % CELLS_PER_WORD );
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+int store_bitboard_to_board( BitBoard *bb, Board *board )
+{
+    if ( bb == NULL || board == NULL || bb->rows != board->rows || bb->columns != board->columns )
+        return EXIT_FAILURE;
+    for ( int i = 0; i < board->rows; i++ )
+    {
+        uint64_t *row = bb->cells + ( size_t )i * bb->words_per_row;
+        for ( int j = 0; j < board->columns; j++ )
+        {
+            board->grid[i][j] = ( Cell )( ( row[j / CELLS_PER_WORD] >> ( j % CELLS_PER_WORD ) ) & 1 );
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+int get_bitboard_cell( BitBoard *bb, int row, int col )
+{
+    uint64_t word = bb->cells[( size_t )row * bb->words_per_row + col / CELLS_PER_WORD];
+    return ( int )( ( word >> ( col % CELLS_PER_WORD ) ) & 1 );
+}
+
+void set_bitboard_cell( BitBoard *bb, int row, int col, int alive )
+{
+    uint64_t *word = &bb->cells[( size_t )row * bb->words_per_row + col / CELLS_PER_WORD];
+    uint64_t bit = ( uint64_t )1 << ( col % CELLS_PER_WORD );
+    if ( alive )
+        *word |= bit;
+    else
+        *word &= ~bit;
+}
+
+int update_next_generation_bitboard( BitBoard *bb )
+{
+    if ( bb == NULL || bb->cells == NULL )
+        return EXIT_FAILURE;
+    update_bitboard_rows( bb, 0, bb->rows );
+    swap_bitboard( bb );
+    return EXIT_SUCCESS;
+}
+
+/* Write the next generation of a block into the back buffer, the changes are only tracked if asked,
+   so the full row updates are compiled without the comparison */
+static inline __attribute__(( always_inline )) int step_block( BitBoard *bb, int first_row, int last_row,
+    int first_word, int last_word, int track, uint32_t rule )
+{
+    const int wpr = bb->words_per_row;
+    const uint64_t mask = last_word_mask( bb );
+    uint64_t changed = 0;
+    for ( int i = first_row; i < last_row; i++ )
+    {
+        const uint64_t *above = i == 0 ? bb->zero_row : bb->cells + ( size_t )( i - 1 ) * wpr;
+        const uint64_t *middle = bb->cells + ( size_t )i * wpr;
+        const uint64_t *below = i == bb->rows - 1 ? bb->zero_row : middle + wpr;
+        uint64_t *out = bb->next + ( size_t )i * wpr;
+        uint64_t a_prev = 0, m_prev = 0, b_prev = 0;
+        if ( first_word > 0 )
+        {
+            a_prev = above[first_word - 1];
+            m_prev = middle[first_word - 1];
+            b_prev = below[first_word - 1];
+        }
+        uint64_t a = above[first_word], m = middle[first_word], b = below[first_word];
+        for ( int w = first_word; w < last_word; w++ )
+        {
+            uint64_t a_next = 0, m_next = 0, b_next = 0;
+            if ( w + 1 < wpr )
+            {
+                a_next = above[w + 1];
+                m_next = middle[w + 1];
+                b_next = below[w + 1];
+            }
+            // B3/S23 keeps its hand written kernel, the other rules are folded by the compiler
+            uint64_t cell = rule == RULE_CONWAY ?
+                step_bitboard_word( a_prev, a, a_next, m_prev, m, m_next, b_prev, b, b_next ) :
+                step_bitboard_word_rule( a_prev, a, a_next, m_prev, m, m_next, b_prev, b, b_next, rule );
+            if ( track )
+            {
+                if ( w == wpr - 1 )
+                    cell &= mask;
+                changed |= cell ^ m;
+            }
+            out[w] = cell;
+            a_prev = a; m_prev = m; b_prev = b;
+            a = a_next; m = m_next; b = b_next;
+        }
+        if ( last_word == wpr )
+            out[wpr - 1] &= mask;
+    }
+    return changed != 0;
+}
+
+/** The kernels of the common rules, the rule is a constant in each of them **/
+#define RULE_KERNELS( name, rule ) \
+    static void step_rows_##name( BitBoard *bb, int first_row, int last_row ) \
+    { \
+        step_block( bb, first_row, last_row, 0, bb->words_per_row, 0, rule ); \
+    } \
+    static int step_block_##name( BitBoard *bb, int first_row, int last_row, int first_word, int last_word ) \
+    { \
+        return step_block( bb, first_row, last_row, first_word, last_word, 1, rule ); \
+    }
+
+RULE_KERNELS( conway, RULE_CONWAY )
+RULE_KERNELS( highlife, RULE_HIGHLIFE )
+RULE_KERNELS( day_and_night, RULE_DAY_AND_NIGHT )
+RULE_KERNELS( seeds, RULE_SEEDS )
+RULE_KERNELS( generic, bb->rule )
+
+
+void update_bitboard_rows( BitBoard *bb, int first_row, int last_row )
+{
+    switch ( bb->rule )
+    {
+        case RULE_CONWAY:
+            step_rows_conway( bb, first_row, last_row );
+            break;
+        case RULE_HIGHLIFE:
+            step_rows_highlife( bb, first_row, last_row );
+            break;
+        case RULE_DAY_AND_NIGHT:
+            step_rows_day_and_night( bb, first_row, last_row );
+            break;
+        case RULE_SEEDS:
+            step_rows_seeds( bb, first_row, last_row );
+            break;
+        default:
+            step_rows_generic( bb, first_row, last_row );
+            break;
+    }
+}
+
+int update_bitboard_block( BitBoard *bb, int first_row, int last_row, int first_word, int last_word )
+{
+    switch ( bb->rule )
+    {
+        case RULE_CONWAY:
+            return step_block_conway( bb, first_row, last_row, first_word, last_word );
+        case RULE_HIGHLIFE:
+            return step_block_highlife( bb, first_row, last_row, first_word, last_word );
+        case RULE_DAY_AND_NIGHT:
+            return step_block_day_and_night( bb, first_row, last_row, first_word, last_word );
+        case RULE_SEEDS:
+            return step_block_seeds( bb, first_row, last_row, first_word, last_word );
+        default:
+            return step_block_generic( bb, first_row, last_row, first_word, last_word );
+    }
+}
+
+void swap_bitboard( BitBoard *bb )
+{
+    // The next generation becomes the current one
+    uint64_t *swap = bb->cells;
+    bb->cells = bb->next;
+    bb->next = swap;
+}
@@ -0,0 +1,226 @@
+/**
+* @file: bitboard.h
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file contains the function prototypes of the bit-packed board backend
+* Every cell is stored as a single bit, 64 cells per word, so a whole word of cells
+* can be updated at once with bitwise adder logic
+**/
+
+
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+
+/** Include all the libraries **/
+#include <stdint.h>
+#include "board.h"
+
+
+/** Define all the marcos of the bit-packed board **/
+#define CELLS_PER_WORD 64       // The number of cells packed into one word
+
+
+/** define all the structs used in the bit-packed board **/
+typedef struct
+{
+    int rows;               // The number of rows in the board
+    int columns;            // The number of columns in the board
+    int words_per_row;      // The number of words in each row, the unused bits of the last word are always 0
+    uint32_t rule;          // The rule of the board, B3/S23 unless it is loaded from a board with another one
+    uint64_t *cells;        // The current generation, rows * words_per_row words
+    uint64_t *next;         // The buffer that the next generation is written into
+    uint64_t *zero_row;     // A row of dead cells used above the first row and below the last row
+    uint64_t *memory;       // The single allocation that holds all the buffers above
+} BitBoard;
+
+
+/** The word kernel shared by every bit-packed backend **/
+/* Get the next generation of a word of 64 cells
+    * Bit j of a word is column j, so the west neighbour of every cell is the row shifted
+    * left by one and the east one is shifted right, the words around fill the edges
+    *
+    * @param a_prev, a, a_next: the words west of, at and east of the word in the row above
+    * @param m_prev, m, m_next: the words west of, at and east of the word itself
+    * @param b_prev, b, b_next: the words west of, at and east of the word in the row below
+    *
+    * @return: the next generation of the word
+*/
+static inline uint64_t step_bitboard_word( uint64_t a_prev, uint64_t a, uint64_t a_next,
+    uint64_t m_prev, uint64_t m, uint64_t m_next, uint64_t b_prev, uint64_t b, uint64_t b_next )
+{
+    uint64_t aw = ( a << 1 ) | ( a_prev >> 63 ), ae = ( a >> 1 ) | ( a_next << 63 );
+    uint64_t mw = ( m << 1 ) | ( m_prev >> 63 ), me = ( m >> 1 ) | ( m_next << 63 );
+    uint64_t bw = ( b << 1 ) | ( b_prev >> 63 ), be = ( b >> 1 ) | ( b_next << 63 );
+    // Add each row of neighbours into a 2 bit number (ones, twos)
+    uint64_t a1 = aw ^ a ^ ae, a2 = ( aw & a ) | ( ae & ( aw ^ a ) );
+    uint64_t b1 = bw ^ b ^ be, b2 = ( bw & b ) | ( be & ( bw ^ b ) );
+    uint64_t m1 = mw ^ me, m2 = mw & me;
+    // Add the three rows, the count is ones + 2 * (number of set twos)
+    uint64_t ones = a1 ^ b1 ^ m1;
+    uint64_t carry = ( a1 & b1 ) | ( m1 & ( a1 ^ b1 ) );
+    // Exactly one of the four twos means the count is 2 or 3
+    uint64_t p = a2 ^ b2, q = m2 ^ carry;
+    uint64_t exactly_one = ( p ^ q ) & ~( ( a2 & b2 ) | ( m2 & carry ) );
+    // B3/S23: alive with 3 neighbours, or alive with 2 neighbours and already alive
+    return exactly_one & ( ones | m );
+}
+
+
+/* Get the next generation of a word of 64 cells under any rule
+    * The neighbours are added into a 4 bit count per cell and the rule picks the counts that
+    * give a living cell. With a constant rule the compiler keeps only the terms of its counts,
+    * so every rule passed as a constant gets its own kernel.
+    *
+    * @param a_prev, a, a_next: the words west of, at and east of the word in the row above
+    * @param m_prev, m, m_next: the words west of, at and east of the word itself
+    * @param b_prev, b, b_next: the words west of, at and east of the word in the row below
+    * @param rule: the rule, see rule.h
+    *
+    * @return: the next generation of the word
+*/
+static inline __attribute__(( always_inline )) uint64_t step_bitboard_word_rule( uint64_t a_prev, uint64_t a, uint64_t a_next,
+    uint64_t m_prev, uint64_t m, uint64_t m_next, uint64_t b_prev, uint64_t b, uint64_t b_next, uint32_t rule )
+{
+    uint64_t aw = ( a << 1 ) | ( a_prev >> 63 ), ae = ( a >> 1 ) | ( a_next << 63 );
+    uint64_t mw = ( m << 1 ) | ( m_prev >> 63 ), me = ( m >> 1 ) | ( m_next << 63 );
+    uint64_t bw = ( b << 1 ) | ( b_prev >> 63 ), be = ( b >> 1 ) | ( b_next << 63 );
+    uint64_t a1 = aw ^ a ^ ae, a2 = ( aw & a ) | ( ae & ( aw ^ a ) );
+    uint64_t b1 = bw ^ b ^ be, b2 = ( bw & b ) | ( be & ( bw ^ b ) );
+    uint64_t m1 = mw ^ me, m2 = mw & me;
+    // The count is ones + 2 * twos + 4 * fours + 8 * eights
+    uint64_t ones = a1 ^ b1 ^ m1;
+    uint64_t carry = ( a1 & b1 ) | ( m1 & ( a1 ^ b1 ) );
+    uint64_t p = a2 ^ b2, q = m2 ^ carry;
+    uint64_t x = a2 & b2, y = m2 & carry, z = p & q;
+    uint64_t twos = p ^ q, fours = x ^ y ^ z, eights = x & y;
+    uint64_t born = 0, stay = 0;
+    // One term per count of the rule, the terms of the counts it does not use are dropped
+#define COUNT_IS( n ) ( ( ( n ) & 1 ? ones : ~ones ) & ( ( n ) & 2 ? twos : ~twos ) & \
+    ( ( n ) & 4 ? fours : ~fours ) & ( ( n ) & 8 ? eights : ~eights ) )
+#define RULE_TERM( n ) \
+    if ( rule & RULE_BIRTH( n ) ) \
+        born |= COUNT_IS( n ); \
+    if ( rule & RULE_SURVIVE( n ) ) \
+        stay |= COUNT_IS( n );
+    RULE_TERM( 0 ) RULE_TERM( 1 ) RULE_TERM( 2 ) RULE_TERM( 3 ) RULE_TERM( 4 )
+    RULE_TERM( 5 ) RULE_TERM( 6 ) RULE_TERM( 7 ) RULE_TERM( 8 )
+#undef RULE_TERM
+#undef COUNT_IS
+    return ( born & ~m ) | ( stay & m );
+}
+
+
+/** Declare all the function prototypes **/
+/* Initialize an empty bit-packed board, its rule is B3/S23
+    *
+    * @param bb: the bit-packed board to be initialized
+    * @param rows: the number of rows in the board
+    * @param columns: the number of columns in the board
+    *
+    * @return: EXIT_SUCCESS if the board is initialized successfully, EXIT_FAILURE otherwise
+*/
+int init_bitboard( BitBoard *bb, int rows, int columns );
+
+/* Free the memory held by a bit-packed board
+    *
+    * @param bb: the bit-packed board to be freed
+    *
+    * @return: none
+*/
+void free_bitboard( BitBoard *bb );
+
+/* Initialize a bit-packed board with the cells and the rule of a board
+    *
+    * @param bb: the bit-packed board to be initialized
+    * @param board: the board to be packed
+    *
+    * @return: EXIT_SUCCESS if the board is packed successfully, EXIT_FAILURE otherwise
+*/
+int load_bitboard_from_board( BitBoard *bb, Board *board );
+
+/* Copy the cells of a bit-packed board back to a board of the same size
+    *
+    * @param bb: the bit-packed board to be unpacked
+    * @param board: the board that receives the cells
+    *
+    * @return: EXIT_SUCCESS if the board is unpacked successfully, EXIT_FAILURE otherwise
+*/
+int store_bitboard_to_board( BitBoard *bb, Board *board );
+
+/* Get the state of a cell in the bit-packed board
+    *
+    * @param bb: the bit-packed board
+    * @param row: the row number of the cell
+    * @param col: the column number of the cell
+    *
+    * @return: 1 if the cell is alive, 0 otherwise
+*/
+int get_bitboard_cell( BitBoard *bb, int row, int col );
+
+/* Set the state of a cell in the bit-packed board
+    *
+    * @param bb: the bit-packed board
+    * @param row: the row number of the cell
+    * @param col: the column number of the cell
+    * @param alive: the new state of the cell
+    *
+    * @return: none
+*/
+void set_bitboard_cell( BitBoard *bb, int row, int col, int alive );
+
+/* Update the bit-packed board to the next generation, 64 cells at a time
+    * The rules and the dead edges are the same as update_next_generation, the common rules have their own kernels
+    *
+    * @param bb: the bit-packed board to be updated
+    *
+    * @return: EXIT_SUCCESS if the board is updated successfully
+*/
+int update_next_generation_bitboard( BitBoard *bb );
+
+/* Write the next generation of a band of rows into the back buffer without swapping the buffers
+    * Bands that do not overlap can be updated at the same time by different threads
+    *
+    * @param bb: the bit-packed board to be updated
+    * @param first_row: the first row of the band
+    * @param last_row: the row after the last row of the band
+    *
+    * @return: none
+*/
+void update_bitboard_rows( BitBoard *bb, int first_row, int last_row );
+
+/* Write the next generation of a block of rows and words into the back buffer without swapping the buffers
+    *
+    * @param bb: the bit-packed board to be updated
+    * @param first_row: the first row of the block
+    * @param last_row: the row after the last row of the block
+    * @param first_word: the first word of each row of the block
+    * @param last_word: the word after the last word of each row of the block
+    *
+    * @return: non zero if any cell of the block changes, 0 otherwise
+*/
+int update_bitboard_block( BitBoard *bb, int first_row, int last_row, int first_word, int last_word );
+
+/* Swap the buffers of the bit-packed board after all its rows are updated
+    *
+    * @param bb: the bit-packed board
+    *
+    * @return: none
+*/
+void swap_bitboard( BitBoard *bb );
+
+
+#endif
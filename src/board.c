@@ -0,0 +1,553 @@
+/**
+* @file: board.c
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file contains all the functions that implement the logic behind Conway's Game of Life
+* All the according function prototypes are defined in board.h
+**/
+
+/** Head files **/
+#define _POSIX_C_SOURCE 200809L
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "board.h"
+#include "pool.h"
+
+
+/** The number of heap allocations made by the board functions, each one goes through board_malloc or board_calloc **/
+static size_t board_allocations = 0;
+
+/** The names of the boundary modes, in the order of BoundaryMode **/
+static const char *boundary_names[BOUNDARY_COUNT] = { "dead", "torus", "klein" };
+
+/** The results of parsing a data file, the values of EXIT_SUCCESS and EXIT_FAILURE are kept **/
+#define DATA_MISMATCH 2     // The data file does not have the size of the configuration
+
+/** A range of whole lines of a data file, parsed by one thread **/
+typedef struct
+{
+    const char *begin;      // The first byte of the range, at the start of a line
+    const char *end;        // The byte after the range, after a new line or at the end of the file
+    size_t first_row;       // The row of the first line of the range
+    size_t rows;            // The number of lines in the range
+    int status;             // EXIT_SUCCESS, EXIT_FAILURE for a malformed file or DATA_MISMATCH
+    size_t error_line;      // The line of the first error, from 1
+    size_t error_column;    // The column of the first error, from 1
+} DataRange;
+
+/** The ranges of a data file parsed by a thread pool **/
+typedef struct
+{
+    Board *board;           // The board that receives the cells
+    DataRange *ranges;      // One range per thread
+} DataJob;
+
+
+/* Allocate memory for the board functions and count the allocation */
+static void *board_malloc( size_t size )
+{
+    board_allocations++;
+    return malloc( size );
+}
+
+/* Allocate zeroed memory for the board functions and count the allocation */
+static void *board_calloc( size_t count, size_t size )
+{
+    board_allocations++;
+    return calloc( count, size );
+}
+
+
+int alloc_board( Board *board )
+{
+    if ( board == NULL || board->rows <= 0 || board->columns <= 0 )
+        return EXIT_FAILURE;
+    // Both grids share one block of row pointers and one block of cells, each with a one cell halo around it
+    size_t stride = ( size_t )board->columns + 2, rows = ( size_t )board->rows + 2;
+    size_t cells = rows * stride;
+    board->row_memory = ( Cell** )board_malloc( 2 * rows * sizeof( Cell* ) );
+    board->cell_memory = ( Cell* )board_calloc( 2 * cells, sizeof( Cell ) );
+    if ( board->row_memory == NULL || board->cell_memory == NULL )
+    {
+        fprintf( stderr, "[Err] Unable to allocate a %d x %d board\n", board->rows, board->columns );
+        free( board->row_memory );
+        free( board->cell_memory );
+        board->row_memory = board->grid = board->next_grid = NULL;
+        board->cell_memory = NULL;
+        return EXIT_FAILURE;
+    }
+    board->grid = board->row_memory + 1;
+    board->next_grid = board->row_memory + rows + 1;
+    for ( int i = -1; i <= board->rows; i++ )
+    {
+        board->grid[i] = board->cell_memory + ( size_t )( i + 1 ) * stride + 1;
+        board->next_grid[i] = board->cell_memory + cells + ( size_t )( i + 1 ) * stride + 1;
+    }
+    return EXIT_SUCCESS;
+}
+
+void free_board( Board *board )
+{
+    if ( board == NULL )
+        return;
+    free( board->row_memory );
+    free( board->cell_memory );
+    board->row_memory = board->grid = board->next_grid = NULL;
+    board->cell_memory = NULL;
+}
+
+size_t get_board_allocation_count( void )
+{
+    return board_allocations;
+}
+
+int read_config_file( char *config_file, Board *board )
+{
+    // Read rows and cols from config file
+    FILE *config = fopen( config_file, "r" );
+    if ( config == NULL )
+    {
+        fprintf( stderr, File_IO_Err );
+        return EXIT_FAILURE;
+    }
+    // Every line holds one setting, the rule and the boundary are optional
+    char line[256], rule[RULE_TEXT_LENGTH], boundary[16];
+    int has_rule = 0, has_boundary = 0;
+    board->rule = RULE_CONWAY;
+    board->boundary = BOUNDARY_DEAD;
+    while( fgets( line, sizeof( line ), config ) != NULL )
+    {
+        if ( sscanf( line, "rows,cols: (%d,%d)", &board->rows, &board->columns ) == 2 ||
+            sscanf( line, "delay: (%d)", &board->delay ) == 1 )
+            continue;
+        if ( sscanf( line, "rule: (%23[^)])", rule ) == 1 )
+            has_rule = 1;
+        else if ( sscanf( line, "boundary: (%15[^)])", boundary ) == 1 )
+            has_boundary = 1;
+    }
+    fclose( config );
+    if ( has_rule && parse_rule( rule, &board->rule ) == EXIT_FAILURE )
+        return EXIT_FAILURE;
+    if ( has_boundary )
+    {
+        int mode = parse_boundary_mode( boundary );
+        if ( mode < 0 )
+        {
+            fprintf( stderr, "[Err] Unknown boundary: %s, it has to be dead, torus or klein\n", boundary );
+            return EXIT_FAILURE;
+        }
+        board->boundary = ( BoundaryMode )mode;
+    }
+    printf( "[!] Program parameter: rows: %d, cols: %d, delay: %d, rule: %s, boundary: %s\n", board->rows, board->columns,
+        board->delay, format_rule( board->rule, rule ), get_boundary_name( board->boundary ) );
+    // Error checking on the configuraiton
+    if ( board->rows < MIN_ROWS || board->columns < MIN_COLS )
+    {
+        fprintf( stderr, "[Err] Board size is too small\n" );
+        return EXIT_FAILURE;
+    }
+    if ( board->delay < MIN_DELAY || board->delay > MAX_DELAY )
+    {
+        fprintf( stderr, "[Err] Delay is out of range\n" );
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+int init_board_from_file( char *config_file, char *data_file, Board *board )
+{
+    if ( config_file == NULL || data_file == NULL || board == NULL )
+        return EXIT_FAILURE;
+    if ( read_config_file( config_file, board ) == EXIT_FAILURE )
+        return EXIT_FAILURE;
+
+    // Read data from data file
+    return read_data_file( data_file, board, 1 );
+}
+
+/* Record the first error of a range */
+static void data_error( DataRange *range, int status, size_t row, const char *line, const char *at )
+{
+    range->status = status;
+    range->error_line = row + 1;
+    range->error_column = ( size_t )( at - line ) + 1;
+}
+
+/* Parse the cells of a range of lines into the rows of the board, in a single pass
+    * Every cell is a 0 or a 1 followed by white space, every line is a row of the board
+*/
+static void parse_data_range( Board *board, DataRange *range )
+{
+    const char *p = range->begin, *end = range->end;
+    size_t row = range->first_row;
+    range->status = EXIT_SUCCESS;
+    while ( p < end )
+    {
+        const char *line = p;
+        if ( row >= ( size_t )board->rows )
+        {
+            data_error( range, DATA_MISMATCH, row, line, p );
+            return;
+        }
+        Cell *cells = board->grid[row];
+        int col = 0;
+        for ( ; p < end && *p != '\n'; p++ )
+        {
+            char c = *p;
+            if ( c == '0' || c == '1' )
+            {
+                if ( col == board->columns )
+                {
+                    data_error( range, DATA_MISMATCH, row, line, p );
+                    return;
+                }
+                cells[col++] = ( Cell )( c - '0' );
+                // A cell is a single digit, the next character has to separate it from the next one
+                if ( p + 1 < end && p[1] != ' ' && p[1] != '\t' && p[1] != '\r' && p[1] != '\n' )
+                {
+                    data_error( range, EXIT_FAILURE, row, line, p + 1 );
+                    return;
+                }
+            }
+            else if ( c != ' ' && c != '\t' && c != '\r' )
+            {
+                data_error( range, EXIT_FAILURE, row, line, p );
+                return;
+            }
+        }
+        if ( col != board->columns )
+        {
+            data_error( range, DATA_MISMATCH, row, line, p );
+            return;
+        }
+        row++;
+        p++;
+    }
+    range->rows = row - range->first_row;
+}
+
+/* The task of each thread of the loader, it counts the lines of its range */
+static void count_data_lines( void *context, int index, int count )
+{
+    ( void )count;
+    DataRange *range = &( ( DataJob* )context )->ranges[index];
+    range->rows = 0;
+    for ( const char *p = range->begin; p < range->end && ( p = memchr( p, '\n', range->end - p ) ) != NULL; p++ )
+        range->rows++;
+    // The last line of the file does not need a new line
+    if ( range->end > range->begin && range->end[-1] != '\n' )
+        range->rows++;
+}
+
+/* The task of each thread of the loader, it parses the cells of its range */
+static void parse_data_lines( void *context, int index, int count )
+{
+    ( void )count;
+    DataJob *job = ( DataJob* )context;
+    parse_data_range( job->board, &job->ranges[index] );
+}
+
+int read_data_file( char *data_file, Board *board, int threads )
+{
+    if ( data_file == NULL || board == NULL || threads < 1 )
+        return EXIT_FAILURE;
+    int fd = open( data_file, O_RDONLY );
+    struct stat st;
+    if ( fd < 0 || fstat( fd, &st ) != 0 )
+    {
+        fprintf( stderr, File_IO_Err );
+        if ( fd >= 0 )
+            close( fd );
+        return EXIT_FAILURE;
+    }
+    // The whole file is mapped and read once, nothing is copied into a buffer
+    size_t size = ( size_t )st.st_size;
+    const char *text = size > 0 ? mmap( NULL, size, PROT_READ, MAP_PRIVATE, fd, 0 ) : NULL;
+    close( fd );
+    if ( text == MAP_FAILED )
+    {
+        fprintf( stderr, File_IO_Err );
+        return EXIT_FAILURE;
+    }
+    if ( alloc_board( board ) == EXIT_FAILURE )
+    {
+        if ( text != NULL )
+            munmap( ( void* )text, size );
+        return EXIT_FAILURE;
+    }
+    // Each thread takes a range of whole lines, small files are read by one thread
+    if ( ( size_t )threads > size / 65536 + 1 )
+        threads = ( int )( size / 65536 + 1 );
+    DataRange *ranges = ( DataRange* )board_calloc( threads, sizeof( DataRange ) );
+    ThreadPool pool;
+    if ( ranges == NULL || ( threads > 1 && init_thread_pool( &pool, threads ) == EXIT_FAILURE ) )
+    {
+        fprintf( stderr, "[Err] Memory allocation failed\n" );
+        free( ranges );
+        free_board( board );
+        if ( text != NULL )
+            munmap( ( void* )text, size );
+        return EXIT_FAILURE;
+    }
+    const char *begin = text;
+    for ( int i = 0; i < threads; i++ )
+    {
+        const char *end = text + size * ( i + 1 ) / threads;
+        if ( i == threads - 1 )
+            end = text + size;
+        else if ( end <= begin )
+            end = begin;
+        else
+        {
+            // The range is moved on to the end of the line it stops in
+            const char *line_end = memchr( end - 1, '\n', text + size - ( end - 1 ) );
+            end = line_end != NULL ? line_end + 1 : text + size;
+        }
+        ranges[i].begin = begin;
+        ranges[i].end = end;
+        begin = end;
+    }
+    DataJob job = { board, ranges };
+    if ( threads > 1 )
+    {
+        // The first row of each range is only known once the lines before it are counted
+        run_thread_pool( &pool, count_data_lines, &job );
+        for ( int i = 1; i < threads; i++ )
+            ranges[i].first_row = ranges[i - 1].first_row + ranges[i - 1].rows;
+        run_thread_pool( &pool, parse_data_lines, &job );
+        free_thread_pool( &pool );
+    }
+    else
+        parse_data_range( board, &ranges[0] );
+    // The first error in the file is reported
+    int code = EXIT_SUCCESS;
+    size_t rows = 0;
+    for ( int i = 0; i < threads && code == EXIT_SUCCESS; i++ )
+    {
+        code = ranges[i].status;
+        rows += ranges[i].rows;
+        if ( code == EXIT_FAILURE )
+            fprintf( stderr, "[Err] %s:%zu:%zu: a cell has to be 0 or 1\n", data_file, ranges[i].error_line, ranges[i].error_column );
+        else if ( code == DATA_MISMATCH )
+            fprintf( stderr, "[!] Your configuration has changed, %s:%zu:%zu does not match %d x %d\n",
+                data_file, ranges[i].error_line, ranges[i].error_column, board->rows, board->columns );
+    }
+    if ( code == EXIT_SUCCESS && rows != ( size_t )board->rows )
+    {
+        fprintf( stderr, "[!] Your configuration has changed, %s has %zu rows instead of %d\n", data_file, rows, board->rows );
+        code = DATA_MISMATCH;
+    }
+    free( ranges );
+    if ( text != NULL )
+        munmap( ( void* )text, size );
+    // The board is only kept when every cell was read
+    if ( code != EXIT_SUCCESS )
+        free_board( board );
+    return code;
+}
+
+int init_board_by_user( Board *board )
+{
+    if ( board == NULL )
+        return EXIT_FAILURE;
+    // Initialize the board, all the cells start dead
+    return alloc_board( board );
+}
+
+int parse_boundary_mode( const char *name )
+{
+    if ( name == NULL )
+        return -1;
+    for ( int i = 0; i < BOUNDARY_COUNT; i++ )
+    {
+        if ( strcmp( name, boundary_names[i] ) == 0 )
+            return i;
+    }
+    return -1;
+}
+
+const char *get_boundary_name( BoundaryMode mode )
+{
+    if ( ( int )mode < 0 || mode >= BOUNDARY_COUNT )
+        return "unknown";
+    return boundary_names[mode];
+}
+
+void fill_halo( Cell *cells, size_t stride, int rows, int columns, BoundaryMode boundary )
+{
+    Cell *first = cells, *last = cells + ( size_t )( rows - 1 ) * stride;
+    Cell *above = cells - stride, *below = cells + ( size_t )rows * stride;
+    int wrap = boundary == BOUNDARY_TORUS || boundary == BOUNDARY_KLEIN;
+    // The columns are filled first, so the corners are carried along with the rows
+    for ( int i = 0; i < rows; i++ )
+    {
+        Cell *row = cells + ( size_t )i * stride;
+        row[-1] = wrap ? row[columns - 1] : 0;
+        row[columns] = wrap ? row[0] : 0;
+    }
+    if ( boundary == BOUNDARY_TORUS )
+    {
+        memcpy( above - 1, last - 1, ( size_t )columns + 2 );
+        memcpy( below - 1, first - 1, ( size_t )columns + 2 );
+    }
+    else if ( boundary == BOUNDARY_KLEIN )
+    {
+        // Crossing the top or the bottom edge mirrors the columns
+        for ( int j = -1; j <= columns; j++ )
+        {
+            above[j] = last[columns - 1 - j];
+            below[j] = first[columns - 1 - j];
+        }
+    }
+    else
+    {
+        memset( above - 1, 0, ( size_t )columns + 2 );
+        memset( below - 1, 0, ( size_t )columns + 2 );
+    }
+}
+
+inline int count_neighbors( Board *b, int row, int col )
+{
+    if ( b == NULL )
+        return EXIT_FAILURE;
+    if ( row < 0 || row >= b->rows || col < 0 || col >= b->columns )
+        return EXIT_FAILURE;
+    int wrap = b->boundary == BOUNDARY_TORUS || b->boundary == BOUNDARY_KLEIN;
+    int count = 0;
+    for ( int i = row -1 ; i <= row + 1; i++ )
+    {
+        for ( int j = col - 1; j <= col + 1; j++ )
+        {
+            if ( i == row && j == col )
+                continue;
+            int r = i, c = j;
+            if ( r < 0 || r >= b->rows )
+            {
+                if ( !wrap )
+                    continue;
+                r = ( r + b->rows ) % b->rows;
+                if ( b->boundary == BOUNDARY_KLEIN )
+                    c = b->columns - 1 - c;
+            }
+            if ( c < 0 || c >= b->columns )
+            {
+                if ( !wrap )
+                    continue;
+                c = ( c + b->columns ) % b->columns;
+            }
+            if ( b->grid[r][c] )
+                count++;
+        }
+    }
+    return count;
+}
+
+int update_next_generation( Board *b )
+{
+    return update_next_generation_tracked( b, NULL );
+}
+
+int update_next_generation_tracked( Board *b, ChangeSet *changes )
+{
+    // The halo holds what lies beyond the edges, so every cell has eight neighbours in memory
+    fill_halo( b->grid[0], ( size_t )b->columns + 2, b->rows, b->columns, b->boundary );
+    // Write the next generation into the back grid, nothing is allocated here
+    for ( int i = 0; i < b->rows; i++ )
+    {
+        const Cell *above = b->grid[i - 1], *middle = b->grid[i], *below = b->grid[i + 1];
+        Cell *out = b->next_grid[i];
+        for ( int j = 0; j < b->columns; j++ )
+        {
+            int count = above[j - 1] + above[j] + above[j + 1] + middle[j - 1] + middle[j + 1] +
+                below[j - 1] + below[j] + below[j + 1];
+            // The rule holds the next state of every count, for both states
+            out[j] = ( Cell )get_next_state( b->rule, middle[j], count );
+            if ( changes != NULL && out[j] != middle[j] )
+                mark_cell_changed( changes, i, j );
+        }
+    }
+    // Swap the grids so that the next generation becomes the current one
+    Cell **swap = b->grid;
+    b->grid = b->next_grid;
+    b->next_grid = swap;
+    return EXIT_SUCCESS;
+}
+
+int clear_all_cells( Board *b )
+{
+    if ( b == NULL )
+        return EXIT_FAILURE;
+    for ( int i = 0; i < b->rows; i++ )
+    {
+        for ( int j = 0; j < b->columns; j++ )
+        {
+            b->grid[i][j] = 0;
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+int write_config_file( char *config_file, Board *board )
+{
+    FILE *config = fopen( config_file, "w" );
+    if ( config == NULL )
+    {
+        fprintf( stderr, File_IO_Err );
+        return EXIT_FAILURE;
+    }
+    fprintf( config, "rows,cols: (%d,%d)\ndelay: (%d)", board->rows, board->columns, board->delay );
+    if ( board->rule != RULE_CONWAY )
+    {
+        char rule[RULE_TEXT_LENGTH];
+        fprintf( config, "\nrule: (%s)", format_rule( board->rule, rule ) );
+    }
+    if ( board->boundary != BOUNDARY_DEAD )
+        fprintf( config, "\nboundary: (%s)", get_boundary_name( board->boundary ) );
+    fclose( config );
+    return EXIT_SUCCESS;
+}
+
+int write_back_to_file( char *config_file, char *data_file, Board *board )
+{
+    // Write config file
+    if ( config_file == NULL || data_file == NULL || board == NULL || write_config_file( config_file, board ) == EXIT_FAILURE )
+        return EXIT_FAILURE;
+
+    // Write data file
+    return write_data_file( data_file, board );
+}
+
+int write_data_file( char *data_file, Board *board )
+{
+    FILE *data = fopen( data_file, "w" );
+    if ( data == NULL )
+    {
+        fprintf( stderr, File_IO_Err );
+        return EXIT_FAILURE;
+    }
+    for ( int i = 0; i < board->rows; i++ )
+    {
+        for ( int j = 0; j < board->columns; j++ )
+        {
+            fprintf( data, "%d ", board->grid[i][j] );
+        }
+        fprintf( data, "\n" );
+    }
+    fclose( data );
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,234 @@
+/**
+* @file: board.h
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file contains all the function prototypes of the board and the simulation
+* Nothing in this file depends on SDL, so it can be used without a display
+**/
+
+
+#ifndef BOARD_H
+#define BOARD_H
+
+
+/** Include all the libraries **/
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include "changes.h"
+#include "rule.h"
+
+
+/** Define all the marcos of the board **/
+#define MIN_ROWS 15         // The minimum rows of the board
+#define MIN_COLS 30         // The minimum columns of the board
+#define MIN_DELAY 20        // The minimum delay between two frames
+#define MAX_DELAY 1000      // The maximum delay between two frames
+#define File_IO_Err "[Err] File could not be accessed, check:\n-> Does file exist?\n-> Directory/file name correct?\n-> Is file corrupted?\n"
+
+
+/** define all the enums and structs used in the board **/
+typedef unsigned char Cell;     // A cell of the board, 1 if it is alive and 0 if it is dead
+
+typedef enum
+{
+    BOUNDARY_DEAD,      // The cells outside the board are always dead
+    BOUNDARY_TORUS,     // The left edge is joined to the right one and the top edge to the bottom one
+    BOUNDARY_KLEIN,     // Like the torus, but the top and bottom edges are joined with the columns reversed
+    BOUNDARY_COUNT      // The number of boundary modes
+} BoundaryMode;
+
+typedef struct
+{
+    int rows;           // The number of rows in the board, only limited by memory
+    int columns;        // The number of columns in the board, only limited by memory
+    int delay;          // The delay between two frames
+    uint32_t rule;      // The birth and survival masks of the rule, see rule.h
+    BoundaryMode boundary;  // What lies beyond the edges of the board
+    Cell **grid;        // The grid of the board, grid[-1] to grid[rows] and columns -1 to columns are a halo of ghost cells
+    Cell **next_grid;   // The grid that the next generation is written into, swapped with grid after each update
+    Cell **row_memory;  // The row pointers of both grids
+    Cell *cell_memory;  // The cells of both grids
+} Board;
+
+
+/** Declare all the function prototypes **/
+/* Allocate both grids of the board, all the cells are dead
+    * Every grid has a one cell halo around it, so grid[i][j] is valid for i from -1 to rows and j from -1 to columns
+    *
+    * @param board: the board with rows and columns set
+    *
+    * @return: EXIT_SUCCESS if the grids are allocated successfully, EXIT_FAILURE otherwise
+*/
+int alloc_board( Board *board );
+
+/* Free both grids of the board, the board struct itself is not freed
+    *
+    * @param board: the board to be freed
+    *
+    * @return: none
+*/
+void free_board( Board *board );
+
+/* Get the number of heap allocations made by the board functions so far
+    * Every allocation in board.c, the update of the board included, is counted here.
+    * The tests use it to check that updating the board never allocates.
+    *
+    * @return: the number of allocations
+*/
+size_t get_board_allocation_count( void );
+
+/* Read the size, delay, rule and boundary of the board from a configuration file, the grids are not allocated
+    * The rule line "rule: (B36/S23)" is optional, without it the rule is B3/S23
+    * The boundary line "boundary: (torus)" is optional, without it the edges are dead
+    *
+    * @param config_file: the name of the configuration file
+    * @param board: the board that receives the rows, columns, delay, rule and boundary
+    *
+    * @return: EXIT_SUCCESS if the configuration is read and valid, EXIT_FAILURE otherwise
+*/
+int read_config_file( char *config_file, Board *board );
+
+/* Initialize the board with the given configuration file and data file
+    *
+    * @param config_file: the name of the configuration file
+    * @param data_file: the name of the data file
+    * @param board: the board to be initialized
+    *
+    * @return: EXIT_SUCCESS if the board is initialized successfully, EXIT_FAILURE otherwise
+*/
+int init_board_from_file( char *config_file, char *data_file, Board *board );
+
+/* Allocate the board and read its cells from a data file in a single pass
+    * The file is mapped into memory and scanned once, its size is checked against the
+    * rows and columns of the board as it is read. With more than one thread, each one
+    * parses a range of whole lines after the lines before it are counted.
+    *
+    * @param data_file: the name of the data file
+    * @param board: the board with rows and columns set, the grids are allocated here
+    * @param threads: the number of threads that parse the file
+    *
+    * @return: EXIT_SUCCESS if the cells are read successfully, 2 if the size of the file does not match
+    *          the board and EXIT_FAILURE otherwise, the board is only allocated on success
+*/
+int read_data_file( char *data_file, Board *board, int threads );
+
+/* Initialize the baord by user
+    *
+    * @param board: the board to be initialized
+    *
+    * @return: EXIT_SUCCESS if the board is initialized successfully, EXIT_FAILURE otherwise
+*/
+int init_board_by_user( Board *board );
+
+/* Get the boundary mode from its name
+    *
+    * @param name: the name of the boundary mode, dead, torus or klein
+    *
+    * @return: the boundary mode, -1 if there is no boundary mode with this name
+*/
+int parse_boundary_mode( const char *name );
+
+/* Get the name of a boundary mode
+    *
+    * @param mode: the boundary mode
+    *
+    * @return: the name of the boundary mode
+*/
+const char *get_boundary_name( BoundaryMode mode );
+
+/* Count the number of neighbors of a given cell, the neighbours beyond the edges follow the boundary of the board
+    *
+    * @param board: the board used in the game
+    * @param row: the row number of the given cell
+    * @param board: the column number of the given cell
+    *
+    * @return: EXIT_SUCCESS if the count is performed successfully
+*/
+int count_neighbors( Board *board, int row, int col );
+
+/* Update the board according to the rules of the game, this function holds the logic behind Conway's Game of Life
+    * The next generation is written into the back grid, which is then swapped with the front one
+    * Each cell follows the rule of the board, B3/S23 unless the configuration gives another one
+    * The halo is filled once from the boundary of the board, so the cells are counted without any bounds check
+    *
+    * @param board: the board to be updated
+    *
+    * @return: EXIT_SUCCESS if the board is updated successfully
+*/
+int update_next_generation( Board *board );
+
+/* Update the board like update_next_generation, and add the tiles where a cell changed to a change set
+    *
+    * @param board: the board to be updated
+    * @param changes: the change set that receives the changed tiles, NULL to not track them
+    *
+    * @return: EXIT_SUCCESS if the board is updated successfully
+*/
+int update_next_generation_tracked( Board *board, ChangeSet *changes );
+
+/* Fill the one cell halo around a grid of rows that are stride cells apart from the cells next to the edges
+    * The grid needs a row above the first row, a row below the last row and a cell before and after each row
+    *
+    * @param cells: the first cell of the first row
+    * @param stride: the number of cells between two rows
+    * @param rows: the number of rows
+    * @param columns: the number of columns
+    * @param boundary: the boundary mode, the halo is dead for dead edges
+    *
+    * @return: none
+*/
+void fill_halo( Cell *cells, size_t stride, int rows, int columns, BoundaryMode boundary );
+
+/* Clear all the cells in the board
+    *
+    * @param board: the board to be cleared
+    *
+    * @return: EXIT_SUCCESS if the board is cleared successfully
+*/
+int clear_all_cells( Board *board );
+
+/* Initialize the board with the given configuration file and data file
+    *
+    * @param config_file: the name of the configuration file
+    * @param data_file: the name of the data file
+    * @param board: the board to be initialized
+    *
+    * @return: EXIT_SUCCESS if the file is saved successfully, EXIT_FAILURE otherwise
+*/
+int write_back_to_file( char *config_file, char *data_file, Board *board );
+
+/* Write the size and delay of the board to a configuration file
+    * The rule is only written if it is not B3/S23 and the boundary only if the edges are not dead
+    *
+    * @param config_file: the name of the configuration file
+    * @param board: the board to be saved
+    *
+    * @return: EXIT_SUCCESS if the file is saved successfully, EXIT_FAILURE otherwise
+*/
+int write_config_file( char *config_file, Board *board );
+
+/* Write the cells of the board to a data file, the configuration file is left untouched
+    *
+    * @param data_file: the name of the data file
+    * @param board: the board to be saved
+    *
+    * @return: EXIT_SUCCESS if the file is saved successfully, EXIT_FAILURE otherwise
+*/
+int write_data_file( char *data_file, Board *board );
+
+
+#endif
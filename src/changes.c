@@ -0,0 +1,96 @@
+/**
+* @file: changes.c
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file contains all the functions of the change sets
+* All the according function prototypes are defined in changes.h
+**/
+
+/** Head files **/
+#include <stdio.h>
+#include <string.h>
+#include "changes.h"
+
+
+int init_change_set( ChangeSet *cs, int rows, int columns )
+{
+    if ( cs == NULL || rows <= 0 || columns <= 0 )
+        return EXIT_FAILURE;
+    cs->tile_rows = ( rows + CHANGE_TILE_SIZE - 1 ) / CHANGE_TILE_SIZE;
+    cs->tile_columns = ( columns + CHANGE_TILE_SIZE - 1 ) / CHANGE_TILE_SIZE;
+    size_t tiles = ( size_t )cs->tile_rows * cs->tile_columns;
+    cs->dirty = ( unsigned char* )calloc( tiles, sizeof( unsigned char ) );
+    cs->tiles = ( int* )malloc( tiles * sizeof( int ) );
+    if ( cs->dirty == NULL || cs->tiles == NULL )
+    {
+        fprintf( stderr, "[Err] Unable to allocate the change set of a %d x %d board\n", rows, columns );
+        free_change_set( cs );
+        return EXIT_FAILURE;
+    }
+    cs->count = 0;
+    cs->all = 0;
+    return EXIT_SUCCESS;
+}
+
+void free_change_set( ChangeSet *cs )
+{
+    if ( cs == NULL )
+        return;
+    free( cs->dirty );
+    free( cs->tiles );
+    cs->dirty = NULL;
+    cs->tiles = NULL;
+    cs->count = 0;
+}
+
+void mark_cell_changed( ChangeSet *cs, int row, int col )
+{
+    int tile = ( row / CHANGE_TILE_SIZE ) * cs->tile_columns + col / CHANGE_TILE_SIZE;
+    if ( !cs->dirty[tile] )
+    {
+        cs->dirty[tile] = 1;
+        cs->tiles[cs->count++] = tile;
+    }
+}
+
+void mark_all_changed( ChangeSet *cs )
+{
+    cs->all = 1;
+}
+
+void merge_change_set( ChangeSet *to, const ChangeSet *from )
+{
+    if ( from->all )
+        to->all = 1;
+    for ( int i = 0; i < from->count; i++ )
+    {
+        int tile = from->tiles[i];
+        if ( !to->dirty[tile] )
+        {
+            to->dirty[tile] = 1;
+            to->tiles[to->count++] = tile;
+        }
+    }
+}
+
+void clear_change_set( ChangeSet *cs )
+{
+    // Only the listed tiles have their flag set
+    for ( int i = 0; i < cs->count; i++ )
+        cs->dirty[cs->tiles[i]] = 0;
+    cs->count = 0;
+    cs->all = 0;
+}
@@ -0,0 +1,104 @@
+/**
+* @file: changes.h
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file contains the function prototypes of the change sets
+* A change set is the list of tiles of the board where a cell changed, filled by the
+* simulation and by the edits of the user and emptied by the renderer once the tiles
+* are drawn. Each tile is only listed once however many of its cells change.
+**/
+
+
+#ifndef CHANGES_H
+#define CHANGES_H
+
+
+/** Include all the libraries **/
+#include <stdlib.h>
+
+
+/** Define all the marcos of the change sets **/
+#define CHANGE_TILE_SIZE 32     // A tile is 32 x 32 cells
+
+
+/** define all the structs used in the change sets **/
+typedef struct
+{
+    int tile_rows;              // The number of rows of tiles
+    int tile_columns;           // The number of columns of tiles
+    unsigned char *dirty;       // 1 for every tile that is in the list
+    int *tiles;                 // The changed tiles, each one is row * tile_columns + column
+    int count;                  // The number of changed tiles
+    int all;                    // 1 if every tile has to be drawn, the list is then not used
+} ChangeSet;
+
+
+/** Declare all the function prototypes **/
+/* Initialize an empty change set for a board
+    *
+    * @param cs: the change set to be initialized
+    * @param rows: the number of rows in the board
+    * @param columns: the number of columns in the board
+    *
+    * @return: EXIT_SUCCESS if the change set is initialized successfully, EXIT_FAILURE otherwise
+*/
+int init_change_set( ChangeSet *cs, int rows, int columns );
+
+/* Free the memory held by a change set
+    *
+    * @param cs: the change set to be freed
+    *
+    * @return: none
+*/
+void free_change_set( ChangeSet *cs );
+
+/* Add the tile of a changed cell to the change set
+    *
+    * @param cs: the change set
+    * @param row: the row of the cell
+    * @param col: the column of the cell
+    *
+    * @return: none
+*/
+void mark_cell_changed( ChangeSet *cs, int row, int col );
+
+/* Mark every tile as changed, for edits that touch the whole board
+    *
+    * @param cs: the change set
+    *
+    * @return: none
+*/
+void mark_all_changed( ChangeSet *cs );
+
+/* Add the tiles of a change set to another one of the same board
+    *
+    * @param to: the change set that receives the tiles
+    * @param from: the change set whose tiles are added, it is not changed
+    *
+    * @return: none
+*/
+void merge_change_set( ChangeSet *to, const ChangeSet *from );
+
+/* Empty the change set once its tiles are drawn
+    *
+    * @param cs: the change set
+    *
+    * @return: none
+*/
+void clear_change_set( ChangeSet *cs );
+
+
+#endif
@@ -0,0 +1,135 @@
+/**
+* @file: cycle.c
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file contains all the functions of the cycle detection
+* All the according function prototypes are defined in cycle.h
+**/
+
+/** Head files **/
+#include "cycle.h"
+
+
+/** The constants of the hash, every word is moved by its position and then mixed **/
+#define CYCLE_POSITION 0x9e3779b97f4a7c15ull
+#define CYCLE_MIX 0xbf58476d1ce4e5b9ull
+#define CYCLE_BUCKETS ( 2 * CYCLE_HISTORY )
+
+
+/* Find the latest remembered generation with the same hash as the next one, it returns 0 if there is none */
+static uint64_t find_period( CycleDetector *cycle, uint64_t hash )
+{
+    int32_t bucket = ( int32_t )( hash & ( CYCLE_BUCKETS - 1 ) );
+    uint64_t later = cycle->generation;
+    // A slot written again by another bucket breaks the chain, its generation or its bucket gives it away
+    for ( int32_t slot = cycle->buckets[bucket]; slot >= 0; slot = cycle->chain[slot] )
+    {
+        if ( cycle->generations[slot] >= later || ( int32_t )( cycle->hashes[slot] & ( CYCLE_BUCKETS - 1 ) ) != bucket )
+            break;
+        if ( cycle->hashes[slot] == hash )
+            return cycle->generation - cycle->generations[slot];
+        later = cycle->generations[slot];
+    }
+    return 0;
+}
+
+/* Get the hash of a remembered generation */
+static uint64_t get_hash( CycleDetector *cycle, uint64_t generation )
+{
+    return cycle->hashes[generation % CYCLE_HISTORY];
+}
+
+
+uint64_t get_state_hash( const uint64_t *words, size_t count )
+{
+    uint64_t hash = 0;
+    for ( size_t i = 0; i < count; i++ )
+    {
+        uint64_t x = ( words[i] ^ ( i * CYCLE_POSITION ) ) * CYCLE_MIX;
+        hash += x ^ ( x >> 31 );
+    }
+    return hash ^ ( hash >> 29 );
+}
+
+void init_cycle_detector( CycleDetector *cycle, uint64_t first_generation )
+{
+    memset( cycle, 0, sizeof( CycleDetector ) );
+    memset( cycle->buckets, 0xff, sizeof( cycle->buckets ) );
+    cycle->generation = first_generation;
+    cycle->first = first_generation;
+}
+
+int add_cycle_generation( CycleDetector *cycle, const uint64_t *words, size_t count )
+{
+    if ( cycle->found )
+        return 1;
+    uint64_t hash = get_state_hash( words, count );
+    uint64_t generation = cycle->generation;
+    // The candidate is compared one period after its hash matched
+    if ( cycle->candidate != NULL && cycle->check_at == generation )
+    {
+        if ( count == cycle->words && memcmp( words, cycle->candidate, count * sizeof( uint64_t ) ) == 0 )
+            cycle->found = 1;
+        else
+            cycle->collisions++;
+        cycle->check_at = 0;
+    }
+    uint64_t period = cycle->found ? 0 : find_period( cycle, hash );
+    if ( period > 0 && cycle->check_at == 0 )
+    {
+        if ( cycle->candidate == NULL || cycle->words != count )
+        {
+            free( cycle->candidate );
+            cycle->candidate = ( uint64_t* )malloc( count * sizeof( uint64_t ) );
+            cycle->words = cycle->candidate != NULL ? count : 0;
+        }
+        if ( cycle->candidate != NULL )
+        {
+            memcpy( cycle->candidate, words, count * sizeof( uint64_t ) );
+            cycle->check_at = generation + period;
+            cycle->candidate_period = period;
+        }
+    }
+    // Remember the generation, the oldest one in its slot is forgotten
+    int32_t slot = ( int32_t )( generation % CYCLE_HISTORY );
+    int32_t bucket = ( int32_t )( hash & ( CYCLE_BUCKETS - 1 ) );
+    cycle->hashes[slot] = hash;
+    cycle->generations[slot] = generation;
+    cycle->chain[slot] = cycle->buckets[bucket];
+    cycle->buckets[bucket] = slot;
+    cycle->generation++;
+    if ( !cycle->found )
+        return 0;
+    // The cycle started where the hashes one period apart first agree, as far back as they are remembered
+    cycle->period = cycle->candidate_period;
+    uint64_t oldest = generation + 1 > CYCLE_HISTORY ? generation + 1 - CYCLE_HISTORY : 0;
+    if ( oldest < cycle->first )
+        oldest = cycle->first;
+    uint64_t first = generation - cycle->period;
+    while ( first > oldest && get_hash( cycle, first - 1 ) == get_hash( cycle, first - 1 + cycle->period ) )
+        first--;
+    cycle->first = first;
+    return 1;
+}
+
+void free_cycle_detector( CycleDetector *cycle )
+{
+    if ( cycle == NULL )
+        return;
+    free( cycle->candidate );
+    cycle->candidate = NULL;
+    cycle->words = 0;
+}
@@ -0,0 +1,96 @@
+/**
+* @file: cycle.h
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file contains the function prototypes of the cycle detection
+* A 64 bit hash of every generation is kept for the last CYCLE_HISTORY generations.
+* When the hash of a generation was already seen p generations earlier, the state is
+* copied and compared with the state p generations later, so a collision of the hashes
+* never reports a cycle that is not there. A still life is a cycle of period 1.
+**/
+
+
+#ifndef CYCLE_H
+#define CYCLE_H
+
+
+/** Include all the libraries **/
+#include <stdint.h>
+#include "board.h"
+
+
+/** Define all the marcos of the cycle detection **/
+#define CYCLE_HISTORY 4096      // The number of generations remembered, the longest period found, a power of two
+
+
+/** define all the structs used by the cycle detection **/
+typedef struct
+{
+    uint64_t hashes[CYCLE_HISTORY];     // The hash of each remembered generation, by generation % CYCLE_HISTORY
+    uint64_t generations[CYCLE_HISTORY];    // The generation held by each slot
+    int32_t chain[CYCLE_HISTORY];       // The slot of the previous generation with the same bucket, -1 at the end
+    int32_t buckets[2 * CYCLE_HISTORY]; // The slot of the latest generation of each bucket, -1 if empty
+    uint64_t generation;                // The generation of the next state added
+    uint64_t *candidate;                // A copy of the state that is checked one period later
+    size_t words;                       // The number of words of a state
+    uint64_t check_at;                  // The generation the candidate is compared at
+    uint64_t candidate_period;          // The period of the candidate
+    int found;                          // 1 once a cycle is verified
+    uint64_t first;                     // The first generation of the cycle
+    uint64_t period;                    // The period of the cycle
+    size_t collisions;                  // The number of hash matches that were not cycles
+} CycleDetector;
+
+
+/** Declare all the function prototypes **/
+/* Get the hash of a bit-packed state, the words are mixed independently so the loop does not wait on itself
+    *
+    * @param words: the state
+    * @param count: the number of words
+    *
+    * @return: the hash
+*/
+uint64_t get_state_hash( const uint64_t *words, size_t count );
+
+/* Initialize an empty cycle detector
+    *
+    * @param cycle: the detector to be initialized
+    * @param first_generation: the generation of the first state that will be added
+    *
+    * @return: none
+*/
+void init_cycle_detector( CycleDetector *cycle, uint64_t first_generation );
+
+/* Add the next generation to a cycle detector
+    *
+    * @param cycle: the detector
+    * @param words: the bit-packed state of the generation
+    * @param count: the number of words, the same for every generation
+    *
+    * @return: 1 once a cycle is verified, the first generation and the period are then set, 0 otherwise
+*/
+int add_cycle_generation( CycleDetector *cycle, const uint64_t *words, size_t count );
+
+/* Free the memory held by a cycle detector
+    *
+    * @param cycle: the detector to be freed
+    *
+    * @return: none
+*/
+void free_cycle_detector( CycleDetector *cycle );
+
+
+#endif
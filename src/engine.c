@@ -0,0 +1,273 @@
+/**
+* @file: engine.c
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file contains all the functions that select and drive the simulation engines
+* All the according function prototypes are defined in engine.h
+**/
+
+/** Head files **/
+#include "engine.h"
+
+
+/** The names of the engines, in the order of EngineType **/
+static const char *engine_names[ENGINE_COUNT] = { "reference", "bitboard", "parallel", "simd", "hashlife", "tiled", "sparse", "lookup" };
+
+
+/* The task of each thread of the parallel engine, it updates one band of rows */
+static void update_band( void *context, int index, int count )
+{
+    BitBoard *bb = ( BitBoard* )context;
+    int first_row = ( int )( ( long long )bb->rows * index / count );
+    int last_row = ( int )( ( long long )bb->rows * ( index + 1 ) / count );
+    update_bitboard_rows( bb, first_row, last_row );
+}
+
+/* Pack a row of cells into the words of a bit-packed board */
+static void pack_cells( const Cell *cells, int columns, uint64_t *words, int words_per_row )
+{
+    memset( words, 0, ( size_t )words_per_row * sizeof( uint64_t ) );
+    for ( int j = 0; j < columns; j++ )
+        words[j / CELLS_PER_WORD] |= ( uint64_t )( cells[j] != 0 ) << ( j % CELLS_PER_WORD );
+}
+
+
+int parse_engine_type( const char *name )
+{
+    if ( name == NULL )
+        return -1;
+    for ( int i = 0; i < ENGINE_COUNT; i++ )
+    {
+        if ( strcmp( name, engine_names[i] ) == 0 )
+            return i;
+    }
+    return -1;
+}
+
+const char *get_engine_name( EngineType type )
+{
+    if ( ( int )type < 0 || type >= ENGINE_COUNT )
+        return "unknown";
+    return engine_names[type];
+}
+
+int init_engine( Engine *engine, EngineType type, int threads, Board *board )
+{
+    if ( engine == NULL || board == NULL || board->grid == NULL || threads < 1 )
+        return EXIT_FAILURE;
+    // Only the engines with a halo around every row can wrap the edges
+    if ( board->boundary != BOUNDARY_DEAD && type != ENGINE_REFERENCE && type != ENGINE_SIMD )
+    {
+        fprintf( stderr, "[Err] The %s engine does not support the %s boundary, use the reference or simd engine\n",
+            get_engine_name( type ), get_boundary_name( board->boundary ) );
+        return EXIT_FAILURE;
+    }
+    memset( engine, 0, sizeof( Engine ) );
+    engine->type = type;
+    engine->threads = threads;
+    engine->board = board;
+    if ( threads > 1 && type != ENGINE_PARALLEL )
+        fprintf( stderr, "[!] The %s engine is single threaded, the thread count is ignored\n", get_engine_name( type ) );
+    switch ( type )
+    {
+        case ENGINE_REFERENCE:
+            return EXIT_SUCCESS;
+        case ENGINE_BITBOARD:
+            return load_bitboard_from_board( &engine->bits, board );
+        case ENGINE_PARALLEL:
+            if ( load_bitboard_from_board( &engine->bits, board ) == EXIT_FAILURE )
+                return EXIT_FAILURE;
+            if ( init_thread_pool( &engine->pool, threads ) == EXIT_FAILURE )
+            {
+                free_bitboard( &engine->bits );
+                return EXIT_FAILURE;
+            }
+            return EXIT_SUCCESS;
+        case ENGINE_SIMD:
+            fprintf( stderr, "[!] The simd engine uses the %s kernel\n", get_simd_kernel_name( get_simd_kernel() ) );
+            return load_simd_board_from_board( &engine->simd, board );
+        case ENGINE_HASHLIFE:
+            return load_hashlife_from_board( &engine->hashlife, board, HASHLIFE_DEFAULT_BUDGET );
+        case ENGINE_TILED:
+            if ( load_bitboard_from_board( &engine->bits, board ) == EXIT_FAILURE )
+                return EXIT_FAILURE;
+            if ( init_tile_map( &engine->tiles, &engine->bits ) == EXIT_FAILURE )
+            {
+                free_bitboard( &engine->bits );
+                return EXIT_FAILURE;
+            }
+            return EXIT_SUCCESS;
+        case ENGINE_SPARSE:
+            return load_sparse_from_board( &engine->sparse, board );
+        case ENGINE_LOOKUP:
+            if ( load_bitboard_from_board( &engine->bits, board ) == EXIT_FAILURE )
+                return EXIT_FAILURE;
+            if ( init_lookup_table( &engine->lookup, board->rule ) == EXIT_FAILURE )
+            {
+                free_bitboard( &engine->bits );
+                return EXIT_FAILURE;
+            }
+            return EXIT_SUCCESS;
+        default:
+            fprintf( stderr, "[Err] Unknown engine\n" );
+            return EXIT_FAILURE;
+    }
+}
+
+int step_engine( Engine *engine, long generations )
+{
+    if ( engine == NULL || generations < 0 )
+        return EXIT_FAILURE;
+    if ( engine->type == ENGINE_HASHLIFE )
+        return step_hashlife( &engine->hashlife, ( uint64_t )generations );
+    for ( long gen = 0; gen < generations; gen++ )
+    {
+        switch ( engine->type )
+        {
+            case ENGINE_REFERENCE:
+                update_next_generation( engine->board );
+                break;
+            case ENGINE_BITBOARD:
+                update_next_generation_bitboard( &engine->bits );
+                break;
+            case ENGINE_PARALLEL:
+                // Every band is finished before the buffers are swapped
+                run_thread_pool( &engine->pool, update_band, &engine->bits );
+                swap_bitboard( &engine->bits );
+                break;
+            case ENGINE_SIMD:
+                update_next_generation_simd( &engine->simd );
+                break;
+            case ENGINE_TILED:
+                update_next_generation_tiled( &engine->bits, &engine->tiles );
+                break;
+            case ENGINE_SPARSE:
+                if ( update_next_generation_sparse( &engine->sparse ) == EXIT_FAILURE )
+                    return EXIT_FAILURE;
+                break;
+            case ENGINE_LOOKUP:
+                if ( update_next_generation_lookup( &engine->bits, &engine->lookup ) == EXIT_FAILURE )
+                    return EXIT_FAILURE;
+                break;
+            default:
+                return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+int store_engine_to_board( Engine *engine )
+{
+    if ( engine == NULL )
+        return EXIT_FAILURE;
+    switch ( engine->type )
+    {
+        case ENGINE_REFERENCE:
+            return EXIT_SUCCESS;
+        case ENGINE_BITBOARD:
+        case ENGINE_PARALLEL:
+        case ENGINE_TILED:
+        case ENGINE_LOOKUP:
+            return store_bitboard_to_board( &engine->bits, engine->board );
+        case ENGINE_SIMD:
+            return store_simd_board_to_board( &engine->simd, engine->board );
+        case ENGINE_HASHLIFE:
+            return store_hashlife_to_board( &engine->hashlife, engine->board );
+        case ENGINE_SPARSE:
+            return store_sparse_to_board( &engine->sparse, engine->board );
+        default:
+            return EXIT_FAILURE;
+    }
+}
+
+int set_engine_cell( Engine *engine, int row, int col, int alive )
+{
+    if ( engine == NULL || row < 0 || row >= engine->board->rows || col < 0 || col >= engine->board->columns )
+        return EXIT_FAILURE;
+    switch ( engine->type )
+    {
+        case ENGINE_REFERENCE:
+            engine->board->grid[row][col] = alive != 0;
+            return EXIT_SUCCESS;
+        case ENGINE_TILED:
+            // The tile is recomputed in the next generation even if nothing around it changed
+            mark_tile_changed( &engine->tiles, row, col );
+            set_bitboard_cell( &engine->bits, row, col, alive );
+            return EXIT_SUCCESS;
+        case ENGINE_BITBOARD:
+        case ENGINE_PARALLEL:
+        case ENGINE_LOOKUP:
+            set_bitboard_cell( &engine->bits, row, col, alive );
+            return EXIT_SUCCESS;
+        case ENGINE_SIMD:
+            engine->simd.cells[( size_t )row * engine->simd.stride + col] = alive != 0;
+            return EXIT_SUCCESS;
+        case ENGINE_SPARSE:
+            return set_sparse_cell( &engine->sparse, col, row, alive != 0 );
+        default:
+            return EXIT_FAILURE;
+    }
+}
+
+const uint64_t *get_engine_words( Engine *engine, size_t *count )
+{
+    if ( engine == NULL || count == NULL )
+        return NULL;
+    BitBoard *bb = &engine->bits;
+    switch ( engine->type )
+    {
+        case ENGINE_BITBOARD:
+        case ENGINE_PARALLEL:
+        case ENGINE_TILED:
+        case ENGINE_LOOKUP:
+            break;
+        case ENGINE_REFERENCE:
+        case ENGINE_SIMD:
+            // These engines keep a byte per cell, the packed copy is only allocated when it is asked for
+            if ( bb->cells == NULL && init_bitboard( bb, engine->board->rows, engine->board->columns ) == EXIT_FAILURE )
+                return NULL;
+            for ( int i = 0; i < bb->rows; i++ )
+            {
+                const Cell *cells = engine->type == ENGINE_SIMD ? engine->simd.cells + ( size_t )i * engine->simd.stride : engine->board->grid[i];
+                pack_cells( cells, bb->columns, bb->cells + ( size_t )i * bb->words_per_row, bb->words_per_row );
+            }
+            break;
+        default:
+            return NULL;
+    }
+    *count = ( size_t )bb->rows * bb->words_per_row;
+    return bb->cells;
+}
+
+void free_engine( Engine *engine )
+{
+    if ( engine == NULL )
+        return;
+    if ( engine->type == ENGINE_PARALLEL )
+        free_thread_pool( &engine->pool );
+    if ( engine->type == ENGINE_SPARSE )
+        free_sparse_universe( &engine->sparse );
+    if ( engine->type == ENGINE_TILED )
+        free_tile_map( &engine->tiles );
+    if ( engine->type == ENGINE_LOOKUP )
+        free_lookup_table( &engine->lookup );
+    // The reference and vectorized engines hold a packed copy once get_engine_words was called
+    free_bitboard( &engine->bits );
+    if ( engine->type == ENGINE_SIMD )
+        free_simd_board( &engine->simd );
+    if ( engine->type == ENGINE_HASHLIFE )
+        free_hashlife( &engine->hashlife );
+}
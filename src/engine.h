@@ -0,0 +1,148 @@
+/**
+* @file: engine.h
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file contains the function prototypes of the simulation engines
+* An engine takes a board, advances it by any number of generations in its own
+* representation and writes the result back to the board
+**/
+
+
+#ifndef ENGINE_H
+#define ENGINE_H
+
+
+/** Include all the libraries **/
+#include "board.h"
+#include "bitboard.h"
+#include "pool.h"
+#include "simd.h"
+#include "hashlife.h"
+#include "tiles.h"
+#include "sparse.h"
+#include "lookup.h"
+
+
+/** define all the enums and structs used by the engines **/
+typedef enum
+{
+    ENGINE_REFERENCE,   // update_next_generation on the board itself
+    ENGINE_BITBOARD,    // update_next_generation_bitboard on a bit-packed copy
+    ENGINE_PARALLEL,    // The bit-packed board split into bands of rows over a thread pool
+    ENGINE_SIMD,        // update_next_generation_simd on a byte per cell copy
+    ENGINE_HASHLIFE,    // A memoised quadtree of an unbounded universe, only the board is written back
+    ENGINE_TILED,       // The bit-packed board, skipping the tiles where nothing changes
+    ENGINE_SPARSE,      // An unbounded universe of 64x64 chunks around the living cells, only the board is written back
+    ENGINE_LOOKUP,      // The bit-packed board stepped by a table of every 4x4 square, 2x2 cells at a time
+    ENGINE_COUNT        // The number of engines
+} EngineType;
+
+typedef struct
+{
+    EngineType type;        // The engine in use
+    int threads;            // The number of threads the engine may use
+    Board *board;           // The board the engine was loaded from
+    BitBoard bits;          // The state of the bit-packed engines
+    ThreadPool pool;        // The threads of the parallel engine
+    SimdBoard simd;         // The state of the vectorized engine
+    HashLife hashlife;      // The state of the HashLife engine
+    TileMap tiles;          // The changed tiles of the tiled engine
+    SparseUniverse sparse;  // The chunks of the sparse engine
+    LookupTable lookup;     // The table of the lookup engine
+} Engine;
+
+
+/** Declare all the function prototypes **/
+/* Get the engine type from its name
+    *
+    * @param name: the name of the engine
+    *
+    * @return: the engine type, -1 if there is no engine with this name
+*/
+int parse_engine_type( const char *name );
+
+/* Get the name of an engine type
+    *
+    * @param type: the engine type
+    *
+    * @return: the name of the engine
+*/
+const char *get_engine_name( EngineType type );
+
+/* Initialize an engine with the cells of a board
+    * Only the reference and vectorized engines support a boundary other than dead edges
+    *
+    * @param engine: the engine to be initialized
+    * @param type: the engine type
+    * @param threads: the number of threads the engine may use
+    * @param board: the board to be simulated
+    *
+    * @return: EXIT_SUCCESS if the engine is initialized successfully, EXIT_FAILURE otherwise
+*/
+int init_engine( Engine *engine, EngineType type, int threads, Board *board );
+
+/* Advance the engine by a number of generations
+    * The HashLife engine advances by all of them at once, so a power of two is a single call
+    *
+    * @param engine: the engine to be stepped
+    * @param generations: the number of generations
+    *
+    * @return: EXIT_SUCCESS if the engine is stepped successfully, EXIT_FAILURE otherwise
+*/
+int step_engine( Engine *engine, long generations );
+
+/* Write the current generation of the engine back to the board it was loaded from
+    *
+    * @param engine: the engine
+    *
+    * @return: EXIT_SUCCESS if the board is written successfully, EXIT_FAILURE otherwise
+*/
+int store_engine_to_board( Engine *engine );
+
+/* Set the state of a cell in the current generation of an engine, without loading the board again
+    * The board the engine was loaded from is not changed, except by the reference engine that steps it
+    * HashLife has no fixed layout to write into, it has to be loaded again after its board is edited
+    *
+    * @param engine: the engine
+    * @param row: the row of the cell
+    * @param col: the column of the cell
+    * @param alive: the new state of the cell
+    *
+    * @return: EXIT_SUCCESS if the cell is set successfully, EXIT_FAILURE if the engine can not set it
+*/
+int set_engine_cell( Engine *engine, int row, int col, int alive );
+
+/* Get the current generation of an engine as bit-packed words, rows of words_per_row words
+    * The bit-packed engines give their own words, the reference and vectorized engines are packed
+    * into a buffer of the engine. HashLife and the sparse engine have no fixed layout to give.
+    *
+    * @param engine: the engine
+    * @param count: receives the number of words
+    *
+    * @return: the words, valid until the engine is stepped, NULL if the engine can not give them
+*/
+const uint64_t *get_engine_words( Engine *engine, size_t *count );
+
+/* Free the memory held by an engine, the board is not freed
+    *
+    * @param engine: the engine to be freed
+    *
+    * @return: none
+*/
+void free_engine( Engine *engine );
+
+
+#endif
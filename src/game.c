@@ -15,8 +15,7 @@
 **/
 
 /**
-* This file contains all the functions that implement the logic behind Conway's Game of Life
-* This file also contains all the rendering functions of the game
+* This file contains all the rendering functions of the game
 * All the according function prototypes are defined in game.h
 **/
 
@@ -25,250 +24,187 @@
 #include "util.h"
 
 
-int init_board_from_file( char *config_file, char *data_file, Board *board )
-{
-    // Read rows and cols from config file
-    FILE *config = fopen( config_file, "r" );
-    if ( config == NULL )
-    {
-        fprintf( stderr, File_IO_Err );
-        return EXIT_FAILURE;
-    }
-    while( !feof( config ) )
-    {
-        fscanf( config, "rows,cols: (%d,%d)\ndelay: (%d)", &board->rows, &board->columns, &board->delay );
-    }
-    fclose( config );
-    printf( "[!] Program parameter: rows: %d, cols: %d, delay: %d\n", board->rows, board->columns, board->delay );
-    // Error checking on the configuraiton
-    if ( board->rows < MIN_ROWS || board->columns < MIN_COLS )
-    {
-        fprintf( stderr, "[Err] Board size is too small\n" );
-        return EXIT_FAILURE;
-    }
-    if ( board->rows > MAX_ROWS || board->columns > MAX_COLS )
-    {
-        fprintf( stderr, "[Err] Board size is too large\n" );
-        return EXIT_FAILURE;
-    }
-    if ( board->delay < MIN_DELAY || board->delay > MAX_DELAY )
-    {
-        fprintf( stderr, "[Err] Delay is out of range\n" );
-        return EXIT_FAILURE;
-    }
-
-    // Read data from data file
-    int count = 0;
-    int row_count = 0;
-    FILE *data = fopen( data_file, "r" );
-    if ( data == NULL )
-    {
-        fprintf( stderr, File_IO_Err );
-        return EXIT_FAILURE;
-    }
-    while( !feof( data ) )
-    {
-        // Count the columns and rows of the data file
-        if ( fgetc( data ) == '\n' )
-        {
-            row_count++;
-        }
-        else
-        {
-            count++;
-        }
-    }
-    printf( "[!] Data file parameter: rows: %d, cols: %d\n", row_count, count / ( 2 * row_count ) );
-    if ( count / ( 2 * row_count ) != board->columns || row_count != board->rows )
-    {
-        fprintf( stderr, "[!] Your configuration has changed\n" );
-        fclose( data );
-        return 2;
-    }
-    // Set the file pointer to the beginning of the file
-    rewind( data );
-    board->grid = ( int** )malloc( board->rows * sizeof( int* ) );
-    while( !feof( data ) )
-    {
-        for ( int i = 0; i < board->rows; i++ )
-        {
-            board->grid[i] = ( int* )malloc( board->columns * sizeof( int ) );
-            for( int j = 0; j < board->columns; j++ )
-            {
-                fscanf( data, "%d ", &board->grid[i][j] );
-            }
-        }
-    }
-    fclose( data );
-    return EXIT_SUCCESS;
-}
-
-int init_board_by_user( Board *board )
-{
-    if ( board == NULL )
-        return EXIT_FAILURE;
-    // Initialize the board
-    board->grid = ( int** )malloc( board->rows * sizeof( int* ) );
-    for ( int i = 0; i < board->rows; i++ )
-    {
-        board->grid[i] = ( int* )malloc( board->columns * sizeof( int ) );
-        for( int j = 0; j < board->columns; j++ )
-        {
-            board->grid[i][j] = 0;
-        }
-    }
-    return EXIT_SUCCESS;
-}
-
 int init_view( Window *view, Board *board )
 {
     if ( view == NULL || board == NULL )
         return EXIT_FAILURE;
-    view->cell_size = 17;
-    view->window_height = ( view->cell_size * board->rows ) + 40;
-    view->window_width = view->cell_size * board->columns;
-    view->height_in_cells = view->window_height / view->cell_size;
+    view->cell_size = DEFAULT_CELL_SIZE;
+    // The window never grows past the maximum view, larger boards are scrolled with the camera
+    long long board_width = ( long long )view->cell_size * board->columns;
+    long long board_height = ( long long )view->cell_size * board->rows;
+    view->window_width = board_width < MAX_VIEW_WIDTH ? ( int )board_width : MAX_VIEW_WIDTH;
+    view->window_height = ( board_height < MAX_VIEW_HEIGHT ? ( int )board_height : MAX_VIEW_HEIGHT ) + HUD_HEIGHT;
+    view->height_in_cells = ( view->window_height - HUD_HEIGHT ) / view->cell_size;
     view->width_in_cells = view->window_width / view->cell_size;
     view->movement_speed_in_cells = 3;
     view->min_movement_speed_in_pixels = view->movement_speed_in_cells * view->cell_size;
-    const int BOARD_HEIGHT = view->window_height / 4;
-    const int BOARD_WIDTH = view->window_width / 4;
-    view->camera_x = ( BOARD_WIDTH - view->width_in_cells ) / 2;
-    view->camera_y = ( BOARD_HEIGHT - view->height_in_cells ) / 2;
+    // Start with the camera in the middle of the board
+    view->camera_x = ( board->columns - view->width_in_cells ) / 2;
+    view->camera_y = ( board->rows - view->height_in_cells ) / 2;
     return EXIT_SUCCESS;
 }
 
-void draw_board( Board* b, Window *view, SDL_Renderer* renderer )
+void move_camera( Window *view, Board *board, int dx, int dy )
 {
-    Uint8 red, green, blue;
-    SDL_Rect rectangle;
-    rectangle.w = rectangle.h = view->cell_size;
-    // Iterate over all cells in the view and draw them to the renderer
-    int screenHeight, screenWidth;
-    SDL_GetRendererOutputSize( renderer, &screenWidth, &screenHeight );
-    for ( int i = 0; i < b->rows; i++ )
-    {
-        for ( int j = 0; j < b->columns; j++ )
-        {
-            red = b->grid[i][j] ? LIVING_CELL_R : DEAD_CELL_R;
-            green = b->grid[i][j] ? LIVING_CELL_G : DEAD_CELL_G;
-            blue = b->grid[i][j] ? LIVING_CELL_B : DEAD_CELL_B;
-            SDL_SetRenderDrawColor( renderer, red, green, blue, 255 );
-            rectangle.x = j * view->cell_size;
-            rectangle.y = i * view->cell_size;
-            SDL_RenderDrawRect( renderer, &rectangle );
-        }
-    }
+    view->camera_x += dx;
+    view->camera_y += dy;
+    // Keep the view inside the board
+    if ( view->camera_x > board->columns - view->width_in_cells )
+        view->camera_x = board->columns - view->width_in_cells;
+    if ( view->camera_y > board->rows - view->height_in_cells )
+        view->camera_y = board->rows - view->height_in_cells;
+    if ( view->camera_x < 0 )
+        view->camera_x = 0;
+    if ( view->camera_y < 0 )
+        view->camera_y = 0;
 }
 
-inline int count_neighbors( Board *b, int row, int col )
+void zoom_view( Window *view, Board *board, int zoom_in )
 {
-    if ( b == NULL )
+    int cell_size = zoom_in ? view->cell_size * 2 : view->cell_size / 2;
+    if ( cell_size < MIN_CELL_SIZE || cell_size > MAX_CELL_SIZE )
+        return;
+    // Keep the cell in the middle of the view where it is
+    int center_x = view->camera_x + view->width_in_cells / 2;
+    int center_y = view->camera_y + view->height_in_cells / 2;
+    view->cell_size = cell_size;
+    view->width_in_cells = view->window_width / cell_size;
+    view->height_in_cells = ( view->window_height - HUD_HEIGHT ) / cell_size;
+    if ( view->width_in_cells > board->columns )
+        view->width_in_cells = board->columns;
+    if ( view->height_in_cells > board->rows )
+        view->height_in_cells = board->rows;
+    view->min_movement_speed_in_pixels = view->movement_speed_in_cells * cell_size;
+    view->camera_x = center_x - view->width_in_cells / 2;
+    view->camera_y = center_y - view->height_in_cells / 2;
+    move_camera( view, board, 0, 0 );
+}
+
+int init_board_texture( BoardTexture *texture, Window *view, SDL_Renderer *renderer )
+{
+    if ( texture == NULL || view == NULL || renderer == NULL )
         return EXIT_FAILURE;
-    if ( row < 0 || row >= b->rows || col < 0 || col >= b->columns )
+    memset( texture, 0, sizeof( BoardTexture ) );
+    // At the smallest cell size every pixel of the view is a cell
+    texture->width = view->window_width;
+    texture->height = view->window_height - HUD_HEIGHT;
+    texture->show_grid = TRUE;
+    texture->cells = SDL_CreateTexture( renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING,
+        texture->width, texture->height );
+    texture->grid = SDL_CreateTexture( renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC,
+        texture->width, texture->height );
+    texture->grid_pixels = ( Uint32* )malloc( ( size_t )texture->width * texture->height * sizeof( Uint32 ) );
+    if ( texture->cells == NULL || texture->grid == NULL || texture->grid_pixels == NULL )
+    {
+        fprintf( stderr, "[Err] Unable to create the board textures, SDL_Error: %s\n", SDL_GetError() );
+        free_board_texture( texture );
         return EXIT_FAILURE;
-    int count = 0;
-    for ( int i = row -1 ; i <= row + 1; i++ )
-    {
-        for ( int j = col - 1; j <= col + 1; j++ )
-        {
-            if ( i == row && j == col )
-                continue;
-            if ( i < 0 || i >= b->rows || j < 0 || j >= b->columns )
-                continue;
-            if ( b->grid[i][j] )
-                count++;
-        }
     }
-    return count;
+    SDL_SetTextureBlendMode( texture->grid, SDL_BLENDMODE_BLEND );
+    return EXIT_SUCCESS;
 }
 
-int update_next_generation( Board *b )
+void free_board_texture( BoardTexture *texture )
 {
-    int count;
-    // Create a temp board to store the data for the next generation
-    Board *next_gen = ( Board* )malloc( sizeof( Board ) );
-    next_gen->rows = b->rows;
-    next_gen->columns = b->columns;
-    // Allocate temporary memory for the temp grid
-    next_gen->grid = ( int** )malloc( b->rows * sizeof( int* ) );
-    for ( int i = 0; i < b->rows; i++ )
-    {
-        next_gen->grid[i] = ( int* )malloc( b->columns * sizeof( int ) );
-        for ( int j = 0; j < b->columns; j++ )
-        {
-            count = count_neighbors( b, i, j );
-            if ( b->grid[i][j] )
-            {
-                if ( count < 2 || count > 3 )
-                    next_gen->grid[i][j] = 0;
-                else
-                    next_gen->grid[i][j] = 1;
-            }
-            else
-            {
-                if ( count == 3 )
-                    next_gen->grid[i][j] = 1;
-                else
-                    next_gen->grid[i][j] = 0;
-            }
-        }
-    }
-    // Copy the next generation grid to the current grid
-    // Do not use memcpy!
-    for ( int i = 0; i < b->rows; i++ )
-    {
-        for ( int j = 0; j < b->columns; j++ )
-        {
-            b->grid[i][j] = next_gen->grid[i][j];
-        }
-    }
-    // Clear the temporary memory
-    free( next_gen );
-    return EXIT_SUCCESS;
+    if ( texture == NULL )
+        return;
+    if ( texture->cells != NULL )
+        SDL_DestroyTexture( texture->cells );
+    if ( texture->grid != NULL )
+        SDL_DestroyTexture( texture->grid );
+    free( texture->grid_pixels );
+    texture->cells = texture->grid = NULL;
+    texture->grid_pixels = NULL;
 }
 
-int clear_all_cells( Board *b )
+/* Draw the lines between the cells into the grid texture, everything else is transparent */
+static void build_grid( BoardTexture *texture, int cell_size )
 {
-    if ( b == NULL )
-        return EXIT_FAILURE;
-    for ( int i = 0; i < b->rows; i++ )
+    const Uint32 line = 0xFF000000u | ( BACKGROUND_R << 16 ) | ( BACKGROUND_G << 8 ) | BACKGROUND_B;
+    for ( int y = 0; y < texture->height; y++ )
     {
-        for ( int j = 0; j < b->columns; j++ )
-        {
-            b->grid[i][j] = 0;
-        }
+        Uint32 *row = texture->grid_pixels + ( size_t )y * texture->width;
+        for ( int x = 0; x < texture->width; x++ )
+            row[x] = y % cell_size == 0 || x % cell_size == 0 ? line : 0;
     }
-    return EXIT_SUCCESS;
+    SDL_UpdateTexture( texture->grid, NULL, texture->grid_pixels, texture->width * sizeof( Uint32 ) );
+    texture->grid_cell_size = cell_size;
 }
 
-int write_back_to_file( char *config_file, char *data_file, Board *board )
+/* Write the cells of a rectangle of the view into the cells texture, the rectangle is in cells from the camera */
+static void write_cells( Board *b, Window *view, BoardTexture *texture, int x, int y, int w, int h )
 {
-    // Write config file
-    FILE *config = fopen( config_file, "w" );
-    if ( config == NULL )
-    {
-        fprintf( stderr, File_IO_Err );
-        return EXIT_FAILURE;
-    }
-    fprintf( config, "rows,cols: (%d,%d)\ndelay: (%d)", board->rows, board->columns, board->delay );
-    fclose( config );
+    const Uint32 living = 0xFF000000u | ( LIVING_CELL_R << 16 ) | ( LIVING_CELL_G << 8 ) | LIVING_CELL_B;
+    const Uint32 dead = 0xFF000000u | ( DEAD_CELL_R << 16 ) | ( DEAD_CELL_G << 8 ) | DEAD_CELL_B;
+    SDL_Rect rect = { x, y, w, h };
+    void *pixels;
+    int pitch;
+    if ( SDL_LockTexture( texture->cells, &rect, &pixels, &pitch ) != 0 )
+        return;
+    for ( int i = 0; i < h; i++ )
+    {
+        const Cell *cells = b->grid[view->camera_y + y + i] + view->camera_x + x;
+        Uint32 *row = ( Uint32* )( ( Uint8* )pixels + ( size_t )i * pitch );
+        for ( int j = 0; j < w; j++ )
+            row[j] = cells[j] ? living : dead;
+    }
+    SDL_UnlockTexture( texture->cells );
+}
 
-    // Write data file
-    FILE *data = fopen( data_file, "w" );
-    if ( data == NULL )
-    {
-        fprintf( stderr, File_IO_Err );
-        return EXIT_FAILURE;
-    }
-    for ( int i = 0; i < board->rows; i++ )
-    {
-        for ( int j = 0; j < board->columns; j++ )
+void draw_board( Board* b, Window *view, BoardTexture *texture, ChangeSet *changes, SDL_Renderer* renderer )
+{
+    // Only the cells under the camera are in the texture, one texel each
+    int width = view->width_in_cells, height = view->height_in_cells;
+    if ( width > b->columns - view->camera_x )
+        width = b->columns - view->camera_x;
+    if ( height > b->rows - view->camera_y )
+        height = b->rows - view->camera_y;
+    if ( width > texture->width )
+        width = texture->width;
+    if ( height > texture->height )
+        height = texture->height;
+    if ( width <= 0 || height <= 0 )
+        return;
+    if ( changes == NULL || changes->all || texture->drawn_x != view->camera_x || texture->drawn_y != view->camera_y ||
+        texture->drawn_width != width || texture->drawn_height != height )
+    {
+        write_cells( b, view, texture, 0, 0, width, height );
+        texture->drawn_x = view->camera_x;
+        texture->drawn_y = view->camera_y;
+        texture->drawn_width = width;
+        texture->drawn_height = height;
+    }
+    else
+    {
+        // Only the changed tiles that are under the camera are written
+        for ( int i = 0; i < changes->count; i++ )
         {
-            fprintf( data, "%d ", board->grid[i][j] );
+            int first_row = changes->tiles[i] / changes->tile_columns * CHANGE_TILE_SIZE - view->camera_y;
+            int first_col = changes->tiles[i] % changes->tile_columns * CHANGE_TILE_SIZE - view->camera_x;
+            int last_row = first_row + CHANGE_TILE_SIZE, last_col = first_col + CHANGE_TILE_SIZE;
+            first_row = first_row > 0 ? first_row : 0;
+            first_col = first_col > 0 ? first_col : 0;
+            last_row = last_row < height ? last_row : height;
+            last_col = last_col < width ? last_col : width;
+            if ( first_row < last_row && first_col < last_col )
+            {
+                write_cells( b, view, texture, first_col, first_row, last_col - first_col, last_row - first_row );
+                texture->drawn_tiles++;
+            }
         }
-        fprintf( data, "\n" );
     }
-    fclose( data );
-    return EXIT_SUCCESS;
+    if ( changes != NULL )
+        clear_change_set( changes );
+    // The texture is scaled up by the cell size in one copy
+    SDL_Rect source = { 0, 0, width, height };
+    SDL_Rect target = { 0, 0, width * view->cell_size, height * view->cell_size };
+    SDL_RenderCopy( renderer, texture->cells, &source, &target );
+    if ( texture->show_grid && view->cell_size >= GRID_MIN_CELL_SIZE )
+    {
+        if ( texture->grid_cell_size != view->cell_size )
+            build_grid( texture, view->cell_size );
+        SDL_Rect grid = { 0, 0, target.w < texture->width ? target.w : texture->width,
+            target.h < texture->height ? target.h : texture->height };
+        SDL_RenderCopy( renderer, texture->grid, &grid, &grid );
+    }
 }
@@ -15,13 +15,13 @@
 **/
 
 /**
-* This file contains all the function prototypes that are used to implement Conway's Game of Life
-* This file also contains all the marcos related to the game
+* This file contains all the function prototypes that are used to display Conway's Game of Life
+* This file also contains all the marcos related to the view, the board itself is defined in board.h
 **/
 
 
-#ifndef BOARD_H
-#define BOARD_H
+#ifndef GAME_H
+#define GAME_H
 
 
 /** Include all the libraries **/
@@ -31,6 +31,7 @@
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_ttf.h>
+#include "board.h"
 
 
 /** Define all the marcos in the game **/
@@ -43,56 +44,47 @@
 #define BACKGROUND_R 245      // The red channel of the background
 #define BACKGROUND_G 245      // The green channel of the background
 #define BACKGROUND_B 245      // The blue channel of the background
-#define MIN_ROWS 15         // The minimum rows of the board
-#define MIN_COLS 30         // The minimum columns of the board
-#define MAX_ROWS 45       // The maximum number of rows in the board
-#define MAX_COLS 80       // The maximum number of columns in the board
-#define MIN_DELAY 20        // The minimum delay between two frames
-#define MAX_DELAY 1000      // The maximum delay between two frames
+#define HUD_HEIGHT 40           // The height of the status bar under the board
+#define DEFAULT_CELL_SIZE 17    // The size of each cell when the window is opened
+#define MIN_CELL_SIZE 1         // The smallest size of each cell when zooming out
+#define MAX_CELL_SIZE 68        // The largest size of each cell when zooming in
+#define MAX_VIEW_WIDTH 1280     // The maximum width of the board view, larger boards are scrolled
+#define MAX_VIEW_HEIGHT 720     // The maximum height of the board view, larger boards are scrolled
+#define GRID_MIN_CELL_SIZE 4    // The grid is only drawn when the cells are at least this large
 
 
-/** define all the structs used in the board **/
+/** define all the structs used in the view **/
 typedef struct
 {
-    int rows;        // The number of rows in the board
-    int columns;     // The number of columns in the board
-    int delay;       // The delay between two frames
-    int **grid;      // The grid of the board
-} Board;
-
-typedef struct
-{
-    int camera_x;                       // The x coordinate of the camera
-    int camera_y;                       // The y coordinate of the camera
+    int camera_x;                       // The column of the board shown at the left edge of the view
+    int camera_y;                       // The row of the board shown at the top edge of the view
     int cell_size;                      // The size of each cell
-    int height_in_cells;                // The height of the board in cells
-    int width_in_cells;                 // The width of the board in cells
+    int height_in_cells;                // The height of the view in cells
+    int width_in_cells;                 // The width of the view in cells
     int window_height;                  // The height of the SDL_Window
     int window_width;                   // The width of the SDL_Window
     int movement_speed_in_cells;        // The speed of the camera movement
     int min_movement_speed_in_pixels;   // The minimum speed of the camera movement
 } Window;
 
+typedef struct
+{
+    SDL_Texture *cells;                 // The streaming texture the cells under the camera are written into, one texel per cell
+    SDL_Texture *grid;                  // The grid lines drawn over the cells, rebuilt when the cell size changes
+    Uint32 *grid_pixels;                // The pixels the grid texture is built from
+    int grid_cell_size;                 // The cell size the grid texture was built for
+    int show_grid;                      // TRUE to draw the grid over the cells
+    int width;                          // The width of both textures, the width of the board view in pixels
+    int height;                         // The height of both textures, the height of the board view in pixels
+    int drawn_x;                        // The camera column the cells texture was drawn for
+    int drawn_y;                        // The camera row the cells texture was drawn for
+    int drawn_width;                    // The number of columns in the cells texture, 0 if it has to be drawn again
+    int drawn_height;                   // The number of rows in the cells texture
+    size_t drawn_tiles;                 // The number of changed tiles drawn so far
+} BoardTexture;
 
-/** Declare all the function prototypes **/
-/* Initialize the board with the given configuration file and data file 
-    *
-    * @param config_file: the name of the configuration file
-    * @param data_file: the name of the data file
-    * @param board: the board to be initialized
-    *
-    * @return: EXIT_SUCCESS if the board is initialized successfully, EXIT_FAILURE otherwise
-*/
-int init_board_from_file( char *config_file, char *data_file, Board *board );
-
-/* Initialize the baord by user
-    *
-    * @param board: the board to be initialized
-    *
-    * @return: EXIT_SUCCESS if the board is initialized successfully, EXIT_FAILURE otherwise
-*/
-int init_board_by_user( Board *board );
 
+/** Declare all the function prototypes **/
 /* Initialize the view according to the SDL_Window 
     *
     * @param view: the view to be initialized
@@ -102,51 +94,59 @@ int init_board_by_user( Board *board );
 */
 int init_view( Window *view, Board *board );
 
-/* Draw the board on the window
+/* Move the camera by a number of cells, the view is kept inside the board
     *
-    * @param board: the board to be drawn
-    * @param window: the window configuration
-    * @param renderer: the renderer to draw the board
+    * @param view: the view configuration
+    * @param board: the board under the view
+    * @param dx: the number of columns to move to the right
+    * @param dy: the number of rows to move down
     *
     * @return: none
 */
-void draw_board( Board* board, Window *player_view, SDL_Renderer* renderer );
+void move_camera( Window *view, Board *board, int dx, int dy );
 
-/* Count the number of neighbors of a given cell
+/* Zoom the view in or out by a factor of two around the middle of the view
     *
-    * @param board: the board used in the game
-    * @param row: the row number of the given cell
-    * @param board: the column number of the given cell
+    * @param view: the view configuration
+    * @param board: the board under the view
+    * @param zoom_in: TRUE to make the cells larger, FALSE to make them smaller
     *
-    * @return: EXIT_SUCCESS if the count is performed successfully
+    * @return: none
 */
-int count_neighbors( Board *board, int row, int col );
+void zoom_view( Window *view, Board *board, int zoom_in );
 
-/* Update the board according to the rules of the game, this function holds the logic behind Conway's Game of Life
+/* Create the textures the board is drawn with, they are as large as the board view so every zoom level fits
     *
-    * @param board: the board to be updated
+    * @param texture: the textures to be created
+    * @param view: the view configuration
+    * @param renderer: the renderer that owns the textures
     *
-    * @return: EXIT_SUCCESS if the board is updated successfully
+    * @return: EXIT_SUCCESS if the textures are created successfully, EXIT_FAILURE otherwise
 */
-int update_next_generation( Board *board );
+int init_board_texture( BoardTexture *texture, Window *view, SDL_Renderer *renderer );
 
-/* Clear all the cells in the board
+/* Destroy the textures the board is drawn with
     *
-    * @param board: the board to be cleared
+    * @param texture: the textures to be destroyed
     *
-    * @return: EXIT_SUCCESS if the board is cleared successfully
+    * @return: none
 */
-int clear_all_cells( Board *board );
+void free_board_texture( BoardTexture *texture );
 
-/* Initialize the board with the given configuration file and data file 
+/* Draw the board on the window, only the cells under the camera are drawn
+    * The cells texture persists between frames and only the changed tiles under the camera are
+    * written into it, it is copied with a single SDL_RenderCopy scaled by the cell size and the
+    * grid is one more copy on top. Moving the camera draws the whole view again.
     *
-    * @param config_file: the name of the configuration file
-    * @param data_file: the name of the data file
-    * @param board: the board to be initialized
+    * @param board: the board to be drawn
+    * @param window: the window configuration
+    * @param texture: the textures the board is drawn with
+    * @param changes: the tiles changed since the last draw, emptied here, NULL to draw the whole view
+    * @param renderer: the renderer to draw the board
     *
-    * @return: EXIT_SUCCESS if the file is saved successfully, EXIT_FAILURE otherwise
+    * @return: none
 */
-int write_back_to_file( char *config_file, char *data_file, Board *board );
+void draw_board( Board* board, Window *player_view, BoardTexture *texture, ChangeSet *changes, SDL_Renderer* renderer );
 
 
 #endif
@@ -0,0 +1,459 @@
+/**
+* @file: hashlife.c
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file contains all the functions of the HashLife engine
+* All the according function prototypes are defined in hashlife.h
+*
+* The garbage collector only runs when a successor computation starts, at that point
+* every node held by the running computation is on the protect stack
+**/
+
+/** Head files **/
+#include "hashlife.h"
+
+
+/** Define the parameters of the node cache **/
+#define INITIAL_BUCKETS ( ( size_t )1 << 16 )  // The number of buckets of a new hash table
+
+
+/* Get the size of the node cache in bytes */
+size_t get_hashlife_memory( HashLife *hl )
+{
+    return hl->node_count * sizeof( HashNode ) + hl->bucket_count * sizeof( HashNode* ) +
+        hl->protect_capacity * sizeof( HashNode* );
+}
+
+/* Hash the four quadrants of a node */
+static size_t hash_quadrants( HashNode *nw, HashNode *ne, HashNode *sw, HashNode *se )
+{
+    uint64_t h = ( uintptr_t )nw;
+    h = h * 0x9E3779B97F4A7C15ULL + ( uintptr_t )ne;
+    h = h * 0x9E3779B97F4A7C15ULL + ( uintptr_t )sw;
+    h = h * 0x9E3779B97F4A7C15ULL + ( uintptr_t )se;
+    return ( size_t )( h ^ ( h >> 29 ) );
+}
+
+/* Double the number of buckets of the hash table */
+static void grow_table( HashLife *hl )
+{
+    size_t count = hl->bucket_count * 2;
+    HashNode **buckets = ( HashNode** )calloc( count, sizeof( HashNode* ) );
+    if ( buckets == NULL )
+        return;     // Longer chains are slower but still correct
+    for ( size_t i = 0; i < hl->bucket_count; i++ )
+    {
+        HashNode *n = hl->buckets[i];
+        while ( n != NULL )
+        {
+            HashNode *chain = n->chain;
+            size_t index = hash_quadrants( n->nw, n->ne, n->sw, n->se ) & ( count - 1 );
+            n->chain = buckets[index];
+            buckets[index] = n;
+            n = chain;
+        }
+    }
+    free( hl->buckets );
+    hl->buckets = buckets;
+    hl->bucket_count = count;
+}
+
+/* Get the canonical node with the given quadrants, it is created if it does not exist yet */
+static HashNode *find_node( HashLife *hl, HashNode *nw, HashNode *ne, HashNode *sw, HashNode *se )
+{
+    size_t index = hash_quadrants( nw, ne, sw, se ) & ( hl->bucket_count - 1 );
+    for ( HashNode *n = hl->buckets[index]; n != NULL; n = n->chain )
+    {
+        if ( n->nw == nw && n->ne == ne && n->sw == sw && n->se == se )
+            return n;
+    }
+    if ( hl->node_count >= hl->bucket_count )
+    {
+        grow_table( hl );
+        index = hash_quadrants( nw, ne, sw, se ) & ( hl->bucket_count - 1 );
+    }
+    HashNode *n = ( HashNode* )malloc( sizeof( HashNode ) );
+    if ( n == NULL )
+    {
+        // Nodes are shared by the whole computation, there is no state to roll back to
+        fprintf( stderr, "[Err] HashLife ran out of memory with %zu nodes\n", hl->node_count );
+        exit( EXIT_FAILURE );
+    }
+    n->nw = nw;
+    n->ne = ne;
+    n->sw = sw;
+    n->se = se;
+    n->result = NULL;
+    n->result_step = -1;
+    n->marked = 0;
+    n->level = nw->level + 1;
+    n->population = nw->population + ne->population + sw->population + se->population;
+    n->chain = hl->buckets[index];
+    hl->buckets[index] = n;
+    hl->node_count++;
+    return n;
+}
+
+/* Keep a node alive until the protect stack is unwound */
+static void protect_node( HashLife *hl, HashNode *n )
+{
+    if ( hl->protect_count == hl->protect_capacity )
+    {
+        size_t capacity = hl->protect_capacity ? hl->protect_capacity * 2 : 256;
+        HashNode **protect = ( HashNode** )realloc( hl->protect, capacity * sizeof( HashNode* ) );
+        if ( protect == NULL )
+        {
+            fprintf( stderr, "[Err] HashLife ran out of memory\n" );
+            exit( EXIT_FAILURE );
+        }
+        hl->protect = protect;
+        hl->protect_capacity = capacity;
+    }
+    hl->protect[hl->protect_count++] = n;
+}
+
+/* Mark a node, its quadrants and its memoised result as in use */
+static void mark_node( HashNode *n )
+{
+    if ( n == NULL || n->level == 0 || n->marked )
+        return;
+    n->marked = 1;
+    mark_node( n->nw );
+    mark_node( n->ne );
+    mark_node( n->sw );
+    mark_node( n->se );
+    mark_node( n->result );
+}
+
+/* Mark everything in use and free the rest */
+static void mark_and_sweep( HashLife *hl )
+{
+    mark_node( hl->root );
+    for ( int level = 1; level <= HASHLIFE_MAX_LEVEL; level++ )
+        mark_node( hl->empty[level] );
+    for ( size_t i = 0; i < hl->protect_count; i++ )
+        mark_node( hl->protect[i] );
+    for ( size_t i = 0; i < hl->bucket_count; i++ )
+    {
+        HashNode **link = &hl->buckets[i];
+        while ( *link != NULL )
+        {
+            HashNode *n = *link;
+            if ( n->marked )
+            {
+                n->marked = 0;
+                link = &n->chain;
+            }
+            else
+            {
+                *link = n->chain;
+                free( n );
+                hl->node_count--;
+            }
+        }
+    }
+}
+
+void collect_hashlife_garbage( HashLife *hl )
+{
+    mark_and_sweep( hl );
+    // If the memoised results alone keep the cache full, forget them too
+    if ( get_hashlife_memory( hl ) > hl->memory_budget / 2 )
+    {
+        for ( size_t i = 0; i < hl->bucket_count; i++ )
+        {
+            for ( HashNode *n = hl->buckets[i]; n != NULL; n = n->chain )
+            {
+                n->result = NULL;
+                n->result_step = -1;
+            }
+        }
+        mark_and_sweep( hl );
+    }
+    // When the live nodes alone exceed the budget, let the cache double before the next collection
+    size_t used = get_hashlife_memory( hl );
+    hl->collect_at = used > hl->memory_budget / 2 ? used * 2 : hl->memory_budget;
+    hl->collections++;
+}
+
+/* Get the 2x2 centre of a 4x4 node one generation later */
+static HashNode *life_4x4( HashLife *hl, HashNode *m )
+{
+    int cell[4][4];
+    HashNode *quadrants[2][2] = { { m->nw, m->ne }, { m->sw, m->se } };
+    for ( int y = 0; y < 4; y++ )
+    {
+        for ( int x = 0; x < 4; x++ )
+        {
+            HashNode *q = quadrants[y / 2][x / 2];
+            HashNode *c = y % 2 == 0 ? ( x % 2 == 0 ? q->nw : q->ne ) : ( x % 2 == 0 ? q->sw : q->se );
+            cell[y][x] = ( int )c->population;
+        }
+    }
+    HashNode *next[2][2];
+    for ( int y = 1; y <= 2; y++ )
+    {
+        for ( int x = 1; x <= 2; x++ )
+        {
+            int count = 0;
+            for ( int i = y - 1; i <= y + 1; i++ )
+                for ( int j = x - 1; j <= x + 1; j++ )
+                    count += cell[i][j];
+            count -= cell[y][x];
+            next[y - 1][x - 1] = &hl->cells[get_next_state( hl->rule, cell[y][x], count )];
+        }
+    }
+    return find_node( hl, next[0][0], next[0][1], next[1][0], next[1][1] );
+}
+
+/* Get the centre of a node (half its width) 2^step generations later, step is at most level - 2 */
+static HashNode *successor( HashLife *hl, HashNode *m, int step )
+{
+    if ( m->population == 0 )
+        return hl->empty[m->level - 1];
+    if ( step > m->level - 2 )
+        step = m->level - 2;
+    if ( m->result != NULL && m->result_step == step )
+        return m->result;
+    size_t unwind = hl->protect_count;
+    protect_node( hl, m );
+    if ( get_hashlife_memory( hl ) > hl->collect_at )
+        collect_hashlife_garbage( hl );
+
+    HashNode *s;
+    if ( m->level == 2 )
+        s = life_4x4( hl, m );
+    else
+    {
+        // The nine overlapping nodes of half the width, each advanced by 2^step or 2^(step - 1)
+        HashNode *a = m->nw, *b = m->ne, *c = m->sw, *d = m->se;
+        HashNode *n[9];
+        n[0] = successor( hl, a, step );
+        protect_node( hl, n[0] );
+        n[1] = successor( hl, find_node( hl, a->ne, b->nw, a->se, b->sw ), step );
+        protect_node( hl, n[1] );
+        n[2] = successor( hl, b, step );
+        protect_node( hl, n[2] );
+        n[3] = successor( hl, find_node( hl, a->sw, a->se, c->nw, c->ne ), step );
+        protect_node( hl, n[3] );
+        n[4] = successor( hl, find_node( hl, a->se, b->sw, c->ne, d->nw ), step );
+        protect_node( hl, n[4] );
+        n[5] = successor( hl, find_node( hl, b->sw, b->se, d->nw, d->ne ), step );
+        protect_node( hl, n[5] );
+        n[6] = successor( hl, c, step );
+        protect_node( hl, n[6] );
+        n[7] = successor( hl, find_node( hl, c->ne, d->nw, c->se, d->sw ), step );
+        protect_node( hl, n[7] );
+        n[8] = successor( hl, d, step );
+        protect_node( hl, n[8] );
+        if ( step < m->level - 2 )
+        {
+            // The nine nodes are already 2^step generations ahead, only their centres are needed
+            s = find_node( hl,
+                find_node( hl, n[0]->se, n[1]->sw, n[3]->ne, n[4]->nw ),
+                find_node( hl, n[1]->se, n[2]->sw, n[4]->ne, n[5]->nw ),
+                find_node( hl, n[3]->se, n[4]->sw, n[6]->ne, n[7]->nw ),
+                find_node( hl, n[4]->se, n[5]->sw, n[7]->ne, n[8]->nw ) );
+        }
+        else
+        {
+            // Advance four overlapping combinations by the second half of the step
+            HashNode *q[4];
+            q[0] = successor( hl, find_node( hl, n[0], n[1], n[3], n[4] ), step );
+            protect_node( hl, q[0] );
+            q[1] = successor( hl, find_node( hl, n[1], n[2], n[4], n[5] ), step );
+            protect_node( hl, q[1] );
+            q[2] = successor( hl, find_node( hl, n[3], n[4], n[6], n[7] ), step );
+            protect_node( hl, q[2] );
+            q[3] = successor( hl, find_node( hl, n[4], n[5], n[7], n[8] ), step );
+            s = find_node( hl, q[0], q[1], q[2], q[3] );
+        }
+    }
+    hl->protect_count = unwind;
+    m->result = s;
+    m->result_step = step;
+    return s;
+}
+
+/* Double the width of the universe, the old root becomes its centre */
+static void expand_root( HashLife *hl )
+{
+    HashNode *r = hl->root, *e = hl->empty[r->level - 1];
+    hl->root = find_node( hl,
+        find_node( hl, e, e, e, r->nw ),
+        find_node( hl, e, e, r->ne, e ),
+        find_node( hl, e, r->sw, e, e ),
+        find_node( hl, r->se, e, e, e ) );
+    hl->origin_x -= ( int64_t )1 << ( r->level - 1 );
+    hl->origin_y -= ( int64_t )1 << ( r->level - 1 );
+}
+
+/* Halve the width of the universe as long as nothing lives outside the centre */
+static void crop_root( HashLife *hl )
+{
+    while ( hl->root->level > 3 )
+    {
+        HashNode *r = hl->root;
+        HashNode *centre = find_node( hl, r->nw->se, r->ne->sw, r->sw->ne, r->se->nw );
+        if ( centre->population != r->population )
+            break;
+        hl->root = centre;
+        hl->origin_x += ( int64_t )1 << ( r->level - 2 );
+        hl->origin_y += ( int64_t )1 << ( r->level - 2 );
+    }
+}
+
+int init_hashlife( HashLife *hl, size_t memory_budget )
+{
+    if ( hl == NULL )
+        return EXIT_FAILURE;
+    memset( hl, 0, sizeof( HashLife ) );
+    hl->rule = RULE_CONWAY;
+    hl->memory_budget = hl->collect_at = memory_budget;
+    hl->bucket_count = INITIAL_BUCKETS;
+    hl->buckets = ( HashNode** )calloc( hl->bucket_count, sizeof( HashNode* ) );
+    if ( hl->buckets == NULL )
+    {
+        fprintf( stderr, "[Err] Unable to allocate the HashLife node cache\n" );
+        return EXIT_FAILURE;
+    }
+    for ( int alive = 0; alive <= 1; alive++ )
+    {
+        hl->cells[alive].population = alive;
+        hl->cells[alive].result_step = -1;
+    }
+    hl->empty[0] = &hl->cells[0];
+    for ( int level = 1; level <= HASHLIFE_MAX_LEVEL; level++ )
+    {
+        HashNode *e = hl->empty[level - 1];
+        hl->empty[level] = find_node( hl, e, e, e, e );
+    }
+    hl->root = hl->empty[3];
+    return EXIT_SUCCESS;
+}
+
+void free_hashlife( HashLife *hl )
+{
+    if ( hl == NULL || hl->buckets == NULL )
+        return;
+    for ( size_t i = 0; i < hl->bucket_count; i++ )
+    {
+        HashNode *n = hl->buckets[i];
+        while ( n != NULL )
+        {
+            HashNode *chain = n->chain;
+            free( n );
+            n = chain;
+        }
+    }
+    free( hl->buckets );
+    free( hl->protect );
+    hl->buckets = NULL;
+    hl->protect = NULL;
+    hl->node_count = hl->bucket_count = hl->protect_count = hl->protect_capacity = 0;
+}
+
+/* Build the node of the given level whose top left cell is (x, y) on the board */
+static HashNode *build_node( HashLife *hl, Board *board, int64_t x, int64_t y, int level )
+{
+    if ( x >= board->columns || y >= board->rows )
+        return hl->empty[level];
+    if ( level == 0 )
+        return &hl->cells[board->grid[y][x] ? 1 : 0];
+    int64_t half = ( int64_t )1 << ( level - 1 );
+    HashNode *nw = build_node( hl, board, x, y, level - 1 );
+    HashNode *ne = build_node( hl, board, x + half, y, level - 1 );
+    HashNode *sw = build_node( hl, board, x, y + half, level - 1 );
+    HashNode *se = build_node( hl, board, x + half, y + half, level - 1 );
+    return find_node( hl, nw, ne, sw, se );
+}
+
+int load_hashlife_from_board( HashLife *hl, Board *board, size_t memory_budget )
+{
+    if ( hl == NULL || board == NULL || board->grid == NULL )
+        return EXIT_FAILURE;
+    if ( init_hashlife( hl, memory_budget ) == EXIT_FAILURE )
+        return EXIT_FAILURE;
+    hl->rule = board->rule;
+    int level = 3;
+    while ( ( ( int64_t )1 << level ) < board->rows || ( ( int64_t )1 << level ) < board->columns )
+        level++;
+    hl->root = build_node( hl, board, 0, 0, level );
+    hl->origin_x = hl->origin_y = 0;
+    return EXIT_SUCCESS;
+}
+
+/* Write the living cells of a node whose top left cell is (x, y) into the board */
+static void store_node( HashNode *n, Board *board, int64_t x, int64_t y )
+{
+    int64_t size = ( int64_t )1 << n->level;
+    if ( n->population == 0 || x >= board->columns || y >= board->rows || x + size <= 0 || y + size <= 0 )
+        return;
+    if ( n->level == 0 )
+    {
+        board->grid[y][x] = 1;
+        return;
+    }
+    int64_t half = size / 2;
+    store_node( n->nw, board, x, y );
+    store_node( n->ne, board, x + half, y );
+    store_node( n->sw, board, x, y + half );
+    store_node( n->se, board, x + half, y + half );
+}
+
+int store_hashlife_to_board( HashLife *hl, Board *board )
+{
+    if ( hl == NULL || board == NULL || board->grid == NULL )
+        return EXIT_FAILURE;
+    clear_all_cells( board );
+    store_node( hl->root, board, hl->origin_x, hl->origin_y );
+    return EXIT_SUCCESS;
+}
+
+int advance_hashlife( HashLife *hl, int step )
+{
+    if ( hl == NULL || step < 0 || step > HASHLIFE_MAX_LEVEL - 4 )
+        return EXIT_FAILURE;
+    // The root has to be at least step + 2 levels high, and padded twice so nothing reaches its edge
+    while ( hl->root->level < step + 1 )
+        expand_root( hl );
+    expand_root( hl );
+    expand_root( hl );
+    if ( hl->root->level > HASHLIFE_MAX_LEVEL )
+    {
+        fprintf( stderr, "[Err] The universe is too large for HashLife\n" );
+        return EXIT_FAILURE;
+    }
+    int level = hl->root->level;
+    hl->root = successor( hl, hl->root, step );
+    hl->origin_x += ( int64_t )1 << ( level - 2 );
+    hl->origin_y += ( int64_t )1 << ( level - 2 );
+    hl->generation += ( uint64_t )1 << step;
+    crop_root( hl );
+    if ( get_hashlife_memory( hl ) > hl->collect_at )
+        collect_hashlife_garbage( hl );
+    return EXIT_SUCCESS;
+}
+
+int step_hashlife( HashLife *hl, uint64_t generations )
+{
+    for ( int step = 0; step < 64 && ( generations >> step ) != 0; step++ )
+    {
+        if ( ( ( generations >> step ) & 1 ) && advance_hashlife( hl, step ) == EXIT_FAILURE )
+            return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
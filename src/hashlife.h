@@ -0,0 +1,145 @@
+/**
+* @file: hashlife.h
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file contains the function prototypes of the HashLife engine
+* The universe is a quadtree of canonical (hash-consed) nodes and the future of every node
+* is memoised, so repeated structure in space and time is only computed once.
+* Unlike the other engines the universe has no edges: patterns that leave the board keep
+* evolving and only the cells inside the board are written back to it.
+**/
+
+
+#ifndef HASHLIFE_H
+#define HASHLIFE_H
+
+
+/** Include all the libraries **/
+#include <stdint.h>
+#include "board.h"
+
+
+/** Define all the marcos of the HashLife engine **/
+#define HASHLIFE_MAX_LEVEL 60               // The largest node is 2^60 cells wide, so coordinates fit in 64 bits
+#define HASHLIFE_DEFAULT_BUDGET ( ( size_t )1 << 30 )   // The default memory budget of the node cache, 1 GiB
+
+
+/** define all the structs used in the HashLife engine **/
+typedef struct HashNode
+{
+    struct HashNode *nw, *ne, *sw, *se;     // The four quadrants, NULL for a single cell
+    struct HashNode *result;                // The memoised centre of the node 2^result_step generations later
+    struct HashNode *chain;                 // The next node in the same bucket of the hash table
+    uint64_t population;                    // The number of living cells in the node
+    int level;                              // The node is 2^level cells wide
+    int result_step;                        // The step of the memoised result, -1 if there is none
+    int marked;                             // Set by the garbage collector on the nodes that are kept
+} HashNode;
+
+typedef struct
+{
+    HashNode **buckets;                     // The hash table of the canonical nodes
+    size_t bucket_count;                    // The number of buckets, always a power of two
+    size_t node_count;                      // The number of nodes in the hash table
+    size_t memory_budget;                   // The number of bytes the node cache may use before collecting garbage
+    size_t collect_at;                      // The size that triggers the next collection, above the budget if the live nodes are
+    HashNode cells[2];                      // The dead and the living cell
+    HashNode *empty[HASHLIFE_MAX_LEVEL + 1];// The empty node of every level
+    HashNode *root;                         // The whole universe
+    int64_t origin_x;                       // The column of the top left cell of the root
+    int64_t origin_y;                       // The row of the top left cell of the root
+    HashNode **protect;                     // The nodes held by the running computation, kept by the garbage collector
+    size_t protect_count;                   // The number of protected nodes
+    size_t protect_capacity;                // The capacity of the protect stack
+    uint64_t generation;                    // The number of generations simulated so far
+    size_t collections;                     // The number of garbage collections so far
+    uint32_t rule;                          // The rule of the universe, every cached result was computed under it
+} HashLife;
+
+
+/** Declare all the function prototypes **/
+/* Initialize an empty HashLife universe
+    *
+    * @param hl: the universe to be initialized
+    * @param memory_budget: the number of bytes the node cache may use
+    *
+    * @return: EXIT_SUCCESS if the universe is initialized successfully, EXIT_FAILURE otherwise
+*/
+int init_hashlife( HashLife *hl, size_t memory_budget );
+
+/* Free every node of a HashLife universe
+    *
+    * @param hl: the universe to be freed
+    *
+    * @return: none
+*/
+void free_hashlife( HashLife *hl );
+
+/* Initialize a HashLife universe with the cells of a board, the top left cell of the board is (0, 0)
+    *
+    * @param hl: the universe to be initialized
+    * @param board: the board to be loaded
+    * @param memory_budget: the number of bytes the node cache may use
+    *
+    * @return: EXIT_SUCCESS if the board is loaded successfully, EXIT_FAILURE otherwise
+*/
+int load_hashlife_from_board( HashLife *hl, Board *board, size_t memory_budget );
+
+/* Write the cells of the universe that are inside the board back to the board
+    *
+    * @param hl: the universe
+    * @param board: the board that receives the cells
+    *
+    * @return: EXIT_SUCCESS if the board is written successfully, EXIT_FAILURE otherwise
+*/
+int store_hashlife_to_board( HashLife *hl, Board *board );
+
+/* Advance the universe by 2^step generations in one call
+    *
+    * @param hl: the universe
+    * @param step: the base 2 logarithm of the number of generations
+    *
+    * @return: EXIT_SUCCESS if the universe is advanced successfully, EXIT_FAILURE otherwise
+*/
+int advance_hashlife( HashLife *hl, int step );
+
+/* Advance the universe by any number of generations, as a sum of powers of two
+    *
+    * @param hl: the universe
+    * @param generations: the number of generations
+    *
+    * @return: EXIT_SUCCESS if the universe is advanced successfully, EXIT_FAILURE otherwise
+*/
+int step_hashlife( HashLife *hl, uint64_t generations );
+
+/* Free the nodes that are not part of the universe, and the memoised results if that is not enough
+    *
+    * @param hl: the universe
+    *
+    * @return: none
+*/
+void collect_hashlife_garbage( HashLife *hl );
+
+/* Get the number of bytes used by the node cache
+    *
+    * @param hl: the universe
+    *
+    * @return: the number of bytes
+*/
+size_t get_hashlife_memory( HashLife *hl );
+
+
+#endif
@@ -0,0 +1,316 @@
+/**
+* @file: headless.c
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file is the entry of the headless batch mode, it is built without SDL
+* It loads a board, advances it by a number of generations as fast as possible,
+* writes the result and reports the throughput
+**/
+
+/** Head files **/
+#define _POSIX_C_SOURCE 200809L
+#include <time.h>
+#include "board.h"
+#include "engine.h"
+#include "binfile.h"
+#include "pattern.h"
+#include "cycle.h"
+
+/** Program parameters **/
+#define USAGE "Usage: ./build/debug/GameOfLifeHeadless [--config <config_file>] [--data <data_file>] --generations <n>\n" \
+    "       [--pattern <rle_or_lif_file>] [--at <row>,<col>] [--output <data_file>] [--output-config <config_file>]\n" \
+    "       [--engine <name>] [--threads <n>] [--memory <MiB>] [--cycle <report|stop>] [--rule <B3/S23>]\n" \
+    "       [--boundary <dead|torus|klein>]\n"
+#define CYCLE_OFF 0         // The generations are not hashed
+#define CYCLE_REPORT 1      // The first cycle is reported and all the generations are run
+#define CYCLE_STOP 2        // The run stops once the first cycle is verified
+
+
+/* Parse a non negative number from a command line argument
+    *
+    * @param text: the argument
+    * @param value: the parsed number
+    *
+    * @return: EXIT_SUCCESS if the argument is a number, EXIT_FAILURE otherwise
+*/
+static int parse_number( const char *text, long *value )
+{
+    char *end;
+    if ( text == NULL || *text == '\0' )
+        return EXIT_FAILURE;
+    *value = strtol( text, &end, 10 );
+    if ( *end != '\0' || *value < 0 )
+        return EXIT_FAILURE;
+    return EXIT_SUCCESS;
+}
+
+/* Get the time in seconds from a monotonic clock
+    *
+    * @return: the time in seconds
+*/
+static double now_in_seconds( void )
+{
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main( int argc, char** argv )
+{
+    // Read command line arguments
+    char *config_file = NULL, *data_file = NULL, *output_file = NULL, *output_config = NULL, *pattern_file = NULL;
+    long generations = -1, threads = 1, memory = -1;
+    int pattern_row = 0, pattern_col = 0;
+    int engine_type = -1;
+    int cycle_mode = CYCLE_OFF;
+    uint32_t rule = 0;
+    int has_rule = 0;
+    int boundary = -1;
+    for ( int i = 1; i < argc; i++ )
+    {
+        char *value = i + 1 < argc ? argv[i + 1] : NULL;
+        if ( value == NULL )
+        {
+            fprintf( stderr, "[Err] Missing value for %s\n%s", argv[i], USAGE );
+            return EXIT_FAILURE;
+        }
+        if ( strcmp( argv[i], "--config" ) == 0 )
+            config_file = value;
+        else if ( strcmp( argv[i], "--data" ) == 0 )
+            data_file = value;
+        else if ( strcmp( argv[i], "--output" ) == 0 )
+            output_file = value;
+        else if ( strcmp( argv[i], "--output-config" ) == 0 )
+            output_config = value;
+        else if ( strcmp( argv[i], "--pattern" ) == 0 )
+            pattern_file = value;
+        else if ( strcmp( argv[i], "--at" ) == 0 )
+        {
+            char end;
+            if ( sscanf( value, "%d,%d%c", &pattern_row, &pattern_col, &end ) != 2 )
+            {
+                fprintf( stderr, "[Err] Invalid place of the pattern: %s\n", value );
+                return EXIT_FAILURE;
+            }
+        }
+        else if ( strcmp( argv[i], "--generations" ) == 0 )
+        {
+            if ( parse_number( value, &generations ) == EXIT_FAILURE )
+            {
+                fprintf( stderr, "[Err] Invalid number of generations: %s\n", value );
+                return EXIT_FAILURE;
+            }
+        }
+        else if ( strcmp( argv[i], "--threads" ) == 0 )
+        {
+            if ( parse_number( value, &threads ) == EXIT_FAILURE || threads < 1 )
+            {
+                fprintf( stderr, "[Err] Invalid number of threads: %s\n", value );
+                return EXIT_FAILURE;
+            }
+        }
+        else if ( strcmp( argv[i], "--memory" ) == 0 )
+        {
+            if ( parse_number( value, &memory ) == EXIT_FAILURE || memory < 1 )
+            {
+                fprintf( stderr, "[Err] Invalid memory budget: %s\n", value );
+                return EXIT_FAILURE;
+            }
+        }
+        else if ( strcmp( argv[i], "--engine" ) == 0 )
+        {
+            engine_type = parse_engine_type( value );
+            if ( engine_type < 0 )
+            {
+                fprintf( stderr, "[Err] Unknown engine: %s\n", value );
+                return EXIT_FAILURE;
+            }
+        }
+        else if ( strcmp( argv[i], "--rule" ) == 0 )
+        {
+            if ( parse_rule( value, &rule ) == EXIT_FAILURE )
+                return EXIT_FAILURE;
+            has_rule = 1;
+        }
+        else if ( strcmp( argv[i], "--boundary" ) == 0 )
+        {
+            boundary = parse_boundary_mode( value );
+            if ( boundary < 0 )
+            {
+                fprintf( stderr, "[Err] The boundary has to be dead, torus or klein: %s\n", value );
+                return EXIT_FAILURE;
+            }
+        }
+        else if ( strcmp( argv[i], "--cycle" ) == 0 )
+        {
+            if ( strcmp( value, "report" ) == 0 )
+                cycle_mode = CYCLE_REPORT;
+            else if ( strcmp( value, "stop" ) == 0 )
+                cycle_mode = CYCLE_STOP;
+            else
+            {
+                fprintf( stderr, "[Err] The cycle detection has to be report or stop: %s\n", value );
+                return EXIT_FAILURE;
+            }
+        }
+        else
+        {
+            fprintf( stderr, "[Err] Unknown option: %s\n%s", argv[i], USAGE );
+            return EXIT_FAILURE;
+        }
+        i++;
+    }
+    // A snapshot file holds the size of the board, so it does not need a configuration file
+    if ( ( data_file == NULL && pattern_file == NULL ) || ( config_file == NULL && !is_bin_file( data_file ) ) ||
+        generations < 0 || ( output_config != NULL && output_file == NULL ) )
+    {
+        printf( USAGE );
+        return EXIT_FAILURE;
+    }
+
+    // Initialize the board
+    Board board;
+    uint64_t first_generation = 0;
+    int code;
+    memset( &board, 0, sizeof( Board ) );
+    if ( data_file == NULL )
+        code = read_config_file( config_file, &board ) == EXIT_SUCCESS ? alloc_board( &board ) : EXIT_FAILURE;
+    else if ( is_bin_file( data_file ) )
+        code = load_board_from_bin( data_file, &board, &first_generation );
+    else if ( ( code = read_config_file( config_file, &board ) ) == EXIT_SUCCESS )
+        code = read_data_file( data_file, &board, ( int )threads );
+    // The pattern is placed over the cells of the data file, or over an empty board of the configured size
+    PatternInfo pattern;
+    if ( code == EXIT_SUCCESS && pattern_file != NULL &&
+        ( code = read_pattern_file( pattern_file, &board, pattern_row, pattern_col, &pattern ) ) == EXIT_SUCCESS )
+        fprintf( stderr, "[!] %zu living cells read from %s\n", pattern.cells, pattern_file );
+    if ( code != EXIT_SUCCESS )
+    {
+        fprintf( stderr, "[Err] The board could not be loaded\n" );
+        free_board( &board );
+        return EXIT_FAILURE;
+    }
+    // The rule and the boundary on the command line override the ones of the configuration or the snapshot
+    char rule_text[RULE_TEXT_LENGTH], pattern_rule[RULE_TEXT_LENGTH];
+    if ( has_rule )
+        board.rule = rule;
+    if ( boundary >= 0 )
+        board.boundary = ( BoundaryMode )boundary;
+    // The bit-packed engines only have dead edges, the vectorized one is the fastest that wraps
+    if ( engine_type < 0 )
+        engine_type = board.boundary == BOUNDARY_DEAD ? ENGINE_BITBOARD : ENGINE_SIMD;
+    if ( pattern_file != NULL && pattern.rule != board.rule )
+        fprintf( stderr, "[!] %s was made for %s, it runs under %s\n", pattern_file,
+            format_rule( pattern.rule, pattern_rule ), format_rule( board.rule, rule_text ) );
+
+    // Run the simulation
+    Engine engine;
+    if ( init_engine( &engine, engine_type, ( int )threads, &board ) == EXIT_FAILURE )
+    {
+        free_board( &board );
+        return EXIT_FAILURE;
+    }
+    if ( memory > 0 )
+    {
+        if ( engine_type != ENGINE_HASHLIFE )
+            fprintf( stderr, "[!] Only the hashlife engine has a memory budget, --memory is ignored\n" );
+        engine.hashlife.memory_budget = engine.hashlife.collect_at = ( size_t )memory << 20;
+    }
+    // Every generation is hashed after its step, so the engine is stepped one generation at a time
+    CycleDetector *cycle = NULL;
+    size_t count;
+    if ( cycle_mode != CYCLE_OFF )
+    {
+        const uint64_t *words = get_engine_words( &engine, &count );
+        cycle = words != NULL ? ( CycleDetector* )malloc( sizeof( CycleDetector ) ) : NULL;
+        if ( cycle == NULL )
+        {
+            fprintf( stderr, "[Err] The %s engine can not detect cycles\n", get_engine_name( engine_type ) );
+            free_engine( &engine );
+            free_board( &board );
+            return EXIT_FAILURE;
+        }
+        init_cycle_detector( cycle, first_generation );
+        add_cycle_generation( cycle, words, count );
+    }
+    double start = now_in_seconds();
+    if ( cycle == NULL )
+        code = step_engine( &engine, generations );
+    else
+    {
+        long run = 0;
+        code = EXIT_SUCCESS;
+        while ( run < generations && code == EXIT_SUCCESS )
+        {
+            code = step_engine( &engine, 1 );
+            run++;
+            if ( code == EXIT_SUCCESS && !cycle->found &&
+                add_cycle_generation( cycle, get_engine_words( &engine, &count ), count ) && cycle_mode == CYCLE_STOP )
+                break;
+        }
+        generations = run;
+    }
+    double elapsed = now_in_seconds() - start;
+    if ( code == EXIT_FAILURE )
+    {
+        fprintf( stderr, "[Err] The simulation failed\n" );
+        free_cycle_detector( cycle );
+        free( cycle );
+        free_engine( &engine );
+        free_board( &board );
+        return EXIT_FAILURE;
+    }
+    if ( cycle != NULL && cycle->found && cycle->period == 1 )
+        printf( "[OK] The board is a still life from generation %llu\n", ( unsigned long long )cycle->first );
+    else if ( cycle != NULL && cycle->found )
+        printf( "[OK] The board entered a cycle of period %llu at generation %llu\n",
+            ( unsigned long long )cycle->period, ( unsigned long long )cycle->first );
+    else if ( cycle != NULL )
+        printf( "[!] No cycle of period up to %d was found\n", CYCLE_HISTORY );
+    if ( cycle != NULL && cycle->collisions > 0 )
+        fprintf( stderr, "[!] %zu hashes matched without a cycle\n", cycle->collisions );
+    free_cycle_detector( cycle );
+    free( cycle );
+    store_engine_to_board( &engine );
+    if ( engine_type == ENGINE_HASHLIFE )
+        fprintf( stderr, "[!] HashLife used %zu nodes (%.1f MiB) and %zu garbage collections\n",
+            engine.hashlife.node_count, get_hashlife_memory( &engine.hashlife ) / 1048576.0, engine.hashlife.collections );
+    if ( engine_type == ENGINE_SPARSE && engine.sparse.population > 0 )
+        fprintf( stderr, "[!] %llu living cells in %zu chunks (%.1f MiB), bounding box (%lld, %lld) to (%lld, %lld)\n",
+            ( unsigned long long )engine.sparse.population, engine.sparse.chunk_count, get_sparse_memory( &engine.sparse ) / 1048576.0,
+            ( long long )engine.sparse.min_x, ( long long )engine.sparse.min_y, ( long long )engine.sparse.max_x, ( long long )engine.sparse.max_y );
+    if ( engine_type == ENGINE_TILED )
+        fprintf( stderr, "[!] %zu tiles recomputed and %zu tiles skipped (%.1f%%)\n", engine.tiles.computed, engine.tiles.skipped,
+            engine.tiles.computed + engine.tiles.skipped > 0 ? 100.0 * engine.tiles.skipped / ( engine.tiles.computed + engine.tiles.skipped ) : 0.0 );
+    free_engine( &engine );
+    double cells = ( double )board.rows * board.columns * generations;
+    printf( "[OK] %ld generations of %d x %d under %s with %s edges and the %s engine in %.3f s (%.1f gen/s, %.3e cells/s)\n",
+        generations, board.rows, board.columns, format_rule( board.rule, rule_text ), get_boundary_name( board.boundary ),
+        get_engine_name( engine_type ), elapsed,
+        elapsed > 0 ? generations / elapsed : 0.0, elapsed > 0 ? cells / elapsed : 0.0 );
+
+    // Write the result
+    if ( output_file != NULL && is_bin_file( output_file ) )
+        code = write_board_to_bin( output_file, &board, first_generation + generations );
+    else if ( output_file != NULL && get_pattern_format( output_file ) != PATTERN_NONE )
+        code = write_pattern_file( output_file, &board );
+    else if ( output_config != NULL && output_file != NULL )
+        code = write_back_to_file( output_config, output_file, &board );
+    else if ( output_file != NULL )
+        code = write_data_file( output_file, &board );
+    free_board( &board );
+    return code;
+}
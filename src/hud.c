@@ -0,0 +1,193 @@
+/**
+* @file: hud.c
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file contains all the functions of the status bar (HUD)
+* All the according function prototypes are defined in hud.h
+**/
+
+/** Head files **/
+#include "hud.h"
+#include "util.h"
+
+
+/* Rasterise every glyph into one surface and upload it as the atlas texture */
+static int build_atlas( Hud *hud, SDL_Renderer *rend, TTF_Font *font, SDL_Color color )
+{
+    SDL_Surface *glyphs[HUD_GLYPH_COUNT];
+    int width = 0, height = 0;
+    for ( int i = 0; i < HUD_GLYPH_COUNT; i++ )
+    {
+        glyphs[i] = TTF_RenderGlyph_Blended( font, ( Uint16 )( HUD_FIRST_GLYPH + i ), color );
+        int advance = 0;
+        TTF_GlyphMetrics( font, ( Uint16 )( HUD_FIRST_GLYPH + i ), NULL, NULL, NULL, NULL, &advance );
+        hud->advances[i] = advance;
+        hud->glyphs[i].x = width;
+        hud->glyphs[i].y = 0;
+        hud->glyphs[i].w = glyphs[i] != NULL ? glyphs[i]->w : 0;
+        hud->glyphs[i].h = glyphs[i] != NULL ? glyphs[i]->h : 0;
+        width += hud->glyphs[i].w;
+        if ( hud->glyphs[i].h > height )
+            height = hud->glyphs[i].h;
+    }
+    // All the glyphs side by side in one row
+    SDL_Surface *atlas = width > 0 && height > 0 ? SDL_CreateRGBSurfaceWithFormat( 0, width, height, 32, SDL_PIXELFORMAT_RGBA32 ) : NULL;
+    if ( atlas != NULL )
+    {
+        for ( int i = 0; i < HUD_GLYPH_COUNT; i++ )
+        {
+            if ( glyphs[i] == NULL )
+                continue;
+            // Copy the alpha of the glyph as it is instead of blending it onto the empty atlas
+            SDL_SetSurfaceBlendMode( glyphs[i], SDL_BLENDMODE_NONE );
+            SDL_BlitSurface( glyphs[i], NULL, atlas, &hud->glyphs[i] );
+        }
+        hud->atlas = SDL_CreateTextureFromSurface( rend, atlas );
+        SDL_FreeSurface( atlas );
+    }
+    for ( int i = 0; i < HUD_GLYPH_COUNT; i++ )
+    {
+        if ( glyphs[i] != NULL )
+            SDL_FreeSurface( glyphs[i] );
+    }
+    if ( hud->atlas == NULL )
+        return EXIT_FAILURE;
+    SDL_SetTextureBlendMode( hud->atlas, SDL_BLENDMODE_BLEND );
+    return EXIT_SUCCESS;
+}
+
+int init_hud( Hud *hud, SDL_Renderer *rend, TTF_Font *font, SDL_Color color, int width, int height )
+{
+    if ( hud == NULL || rend == NULL || width <= 0 || height <= 0 )
+        return EXIT_FAILURE;
+    memset( hud, 0, sizeof( Hud ) );
+    if ( font == NULL || build_atlas( hud, rend, font, color ) == EXIT_FAILURE )
+    {
+        fprintf( stderr, "[Err] Unable to create the glyph atlas of the HUD, SDL_Error: %s\n", SDL_GetError() );
+        free_hud( hud );
+        return EXIT_FAILURE;
+    }
+    hud->width = width;
+    hud->height = height;
+    hud->texture = SDL_CreateTexture( rend, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET, width, height );
+    if ( hud->texture == NULL )
+    {
+        fprintf( stderr, "[Err] Unable to create the HUD texture, SDL_Error: %s\n", SDL_GetError() );
+        free_hud( hud );
+        return EXIT_FAILURE;
+    }
+    SDL_SetTextureBlendMode( hud->texture, SDL_BLENDMODE_BLEND );
+    hud->dirty = TRUE;
+    return EXIT_SUCCESS;
+}
+
+void free_hud( Hud *hud )
+{
+    if ( hud == NULL )
+        return;
+    if ( hud->atlas != NULL )
+        SDL_DestroyTexture( hud->atlas );
+    if ( hud->texture != NULL )
+        SDL_DestroyTexture( hud->texture );
+    hud->atlas = hud->texture = NULL;
+}
+
+/* Get an item of the HUD and move it, the HUD is laid out again if it moves */
+static HudItem *get_item( Hud *hud, int index, int x, int y )
+{
+    if ( hud == NULL || index < 0 || index >= HUD_MAX_ITEMS )
+        return NULL;
+    if ( index >= hud->item_count )
+    {
+        for ( int i = hud->item_count; i <= index; i++ )
+            memset( &hud->items[i], 0, sizeof( HudItem ) );
+        hud->item_count = index + 1;
+        hud->dirty = TRUE;
+    }
+    HudItem *item = &hud->items[index];
+    if ( item->x != x || item->y != y )
+    {
+        item->x = x;
+        item->y = y;
+        hud->dirty = TRUE;
+    }
+    return item;
+}
+
+int set_hud_text( Hud *hud, int index, int x, int y, const char *text )
+{
+    HudItem *item = get_item( hud, index, x, y );
+    if ( item == NULL || text == NULL )
+        return EXIT_FAILURE;
+    if ( item->label == NULL && strncmp( item->text, text, HUD_TEXT_LENGTH - 1 ) == 0 )
+        return EXIT_SUCCESS;
+    item->label = NULL;
+    snprintf( item->text, HUD_TEXT_LENGTH, "%s", text );
+    hud->dirty = TRUE;
+    return EXIT_SUCCESS;
+}
+
+int set_hud_value( Hud *hud, int index, int x, int y, const char *label, long value )
+{
+    HudItem *item = get_item( hud, index, x, y );
+    if ( item == NULL || label == NULL )
+        return EXIT_FAILURE;
+    // The number is only formatted when it changes
+    if ( item->label == label && item->value == value )
+        return EXIT_SUCCESS;
+    item->label = label;
+    item->value = value;
+    snprintf( item->text, HUD_TEXT_LENGTH, "%s%ld", label, value );
+    hud->dirty = TRUE;
+    return EXIT_SUCCESS;
+}
+
+/* Copy the glyphs of every string into the HUD texture */
+static void layout_hud( Hud *hud, SDL_Renderer *rend )
+{
+    Uint8 r, g, b, a;
+    SDL_GetRenderDrawColor( rend, &r, &g, &b, &a );
+    SDL_SetRenderTarget( rend, hud->texture );
+    SDL_SetRenderDrawColor( rend, 0, 0, 0, 0 );
+    SDL_RenderClear( rend );
+    for ( int i = 0; i < hud->item_count; i++ )
+    {
+        int pen = hud->items[i].x;
+        for ( const char *c = hud->items[i].text; *c != '\0'; c++ )
+        {
+            int glyph = ( unsigned char )*c - HUD_FIRST_GLYPH;
+            if ( glyph < 0 || glyph >= HUD_GLYPH_COUNT )
+                glyph = '?' - HUD_FIRST_GLYPH;
+            SDL_Rect target = { pen, hud->items[i].y, hud->glyphs[glyph].w, hud->glyphs[glyph].h };
+            SDL_RenderCopy( rend, hud->atlas, &hud->glyphs[glyph], &target );
+            pen += hud->advances[glyph];
+        }
+    }
+    SDL_SetRenderTarget( rend, NULL );
+    SDL_SetRenderDrawColor( rend, r, g, b, a );
+    hud->dirty = FALSE;
+    hud->layouts++;
+}
+
+void draw_hud( Hud *hud, SDL_Renderer *rend, int x, int y )
+{
+    if ( hud == NULL || hud->texture == NULL )
+        return;
+    if ( hud->dirty )
+        layout_hud( hud, rend );
+    SDL_Rect target = { x, y, hud->width, hud->height };
+    SDL_RenderCopy( rend, hud->texture, NULL, &target );
+}
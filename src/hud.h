@@ -0,0 +1,124 @@
+/**
+* @file: hud.h
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file contains the function prototypes of the status bar (HUD)
+* Every printable ASCII glyph of the font is rasterised once into an atlas texture.
+* The strings are laid out from the atlas into a HUD texture only when one of them
+* changes, and the whole HUD is then drawn with a single copy every frame.
+**/
+
+
+#ifndef HUD_H
+#define HUD_H
+
+
+/** Include all the libraries **/
+#include "game.h"
+
+
+/** Define all the marcos of the HUD **/
+#define HUD_FIRST_GLYPH 32      // The first glyph in the atlas, the space
+#define HUD_GLYPH_COUNT 95      // The number of glyphs in the atlas, up to the tilde
+#define HUD_MAX_ITEMS 8         // The number of strings the HUD can show
+#define HUD_TEXT_LENGTH 64      // The maximum length of each string, including the terminator
+
+
+/** define all the structs used in the HUD **/
+typedef struct
+{
+    char text[HUD_TEXT_LENGTH];         // The string shown
+    const char *label;                  // The label of a number item, NULL for a plain string
+    long value;                         // The number shown after the label
+    int x;                              // The x coordinate of the string in the HUD
+    int y;                              // The y coordinate of the string in the HUD
+} HudItem;
+
+typedef struct
+{
+    SDL_Texture *atlas;                 // Every glyph of the font, rasterised once
+    SDL_Rect glyphs[HUD_GLYPH_COUNT];   // The place of each glyph in the atlas
+    int advances[HUD_GLYPH_COUNT];      // The distance from each glyph to the next one
+    SDL_Texture *texture;               // The laid out HUD, copied to the window every frame
+    int width;                          // The width of the HUD
+    int height;                         // The height of the HUD
+    HudItem items[HUD_MAX_ITEMS];       // The strings of the HUD
+    int item_count;                     // The number of strings in use
+    int dirty;                          // TRUE if a string changed since the HUD was laid out
+    size_t layouts;                     // The number of times the HUD was laid out
+} Hud;
+
+
+/** Declare all the function prototypes **/
+/* Rasterise the glyph atlas and create the HUD texture
+    *
+    * @param hud: the HUD to be initialized
+    * @param rend: the renderer that owns the textures, it has to support render targets
+    * @param font: the font of the HUD
+    * @param color: the color of the text
+    * @param width: the width of the HUD
+    * @param height: the height of the HUD
+    *
+    * @return: EXIT_SUCCESS if the HUD is initialized successfully, EXIT_FAILURE otherwise
+*/
+int init_hud( Hud *hud, SDL_Renderer *rend, TTF_Font *font, SDL_Color color, int width, int height );
+
+/* Destroy the textures of the HUD
+    *
+    * @param hud: the HUD to be freed
+    *
+    * @return: none
+*/
+void free_hud( Hud *hud );
+
+/* Set a string of the HUD, the HUD is only laid out again if the string or its place changes
+    *
+    * @param hud: the HUD
+    * @param index: the index of the string
+    * @param x: the x coordinate of the string in the HUD
+    * @param y: the y coordinate of the string in the HUD
+    * @param text: the string
+    *
+    * @return: EXIT_SUCCESS if the string is set successfully, EXIT_FAILURE otherwise
+*/
+int set_hud_text( Hud *hud, int index, int x, int y, const char *text );
+
+/* Set a labelled number of the HUD, it is only formatted if the number or the label changes
+    *
+    * @param hud: the HUD
+    * @param index: the index of the string
+    * @param x: the x coordinate of the string in the HUD
+    * @param y: the y coordinate of the string in the HUD
+    * @param label: the text in front of the number, it has to stay valid
+    * @param value: the number
+    *
+    * @return: EXIT_SUCCESS if the number is set successfully, EXIT_FAILURE otherwise
+*/
+int set_hud_value( Hud *hud, int index, int x, int y, const char *label, long value );
+
+/* Draw the HUD with a single copy, it is laid out first if a string changed
+    *
+    * @param hud: the HUD
+    * @param rend: the renderer to draw the HUD
+    * @param x: the x coordinate of the HUD in the window
+    * @param y: the y coordinate of the HUD in the window
+    *
+    * @return: none
+*/
+void draw_hud( Hud *hud, SDL_Renderer *rend, int x, int y );
+
+
+#endif
@@ -0,0 +1,143 @@
+/**
+* @file: lookup.c
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file contains all the functions of the lookup table engine
+* All the according function prototypes are defined in lookup.h
+**/
+
+/** Head files **/
+#include "lookup.h"
+
+
+/* Get the next state of the cell at row r and column c of a 4x4 square */
+static int get_square_cell( uint32_t rule, unsigned square, int r, int c )
+{
+    int count = 0;
+    for ( int i = r - 1; i <= r + 1; i++ )
+        for ( int j = c - 1; j <= c + 1; j++ )
+            if ( ( i != r || j != c ) && ( ( square >> ( 4 * i + j ) ) & 1 ) )
+                count++;
+    return get_next_state( rule, ( int )( ( square >> ( 4 * r + c ) ) & 1 ), count );
+}
+
+/* Get the index of the square made of the 4 bits from bit s of four rows */
+static inline unsigned get_square( uint64_t r0, uint64_t r1, uint64_t r2, uint64_t r3, int s )
+{
+    return ( unsigned )( ( ( r0 >> s ) & 15 ) | ( ( ( r1 >> s ) & 15 ) << 4 ) |
+        ( ( ( r2 >> s ) & 15 ) << 8 ) | ( ( ( r3 >> s ) & 15 ) << 12 ) );
+}
+
+/* Write the next generation of rows i and i + 1 into the back buffer */
+static void step_row_pair( BitBoard *bb, const uint8_t *table, int i )
+{
+    const int wpr = bb->words_per_row;
+    int used = bb->columns % CELLS_PER_WORD;
+    const uint64_t mask = used == 0 ? ~( uint64_t )0 : ( ( uint64_t )1 << used ) - 1;
+    // Rows i - 1 to i + 2 are read, the rows outside the board are dead
+    const uint64_t *row1 = bb->cells + ( size_t )i * wpr;
+    const uint64_t *row0 = i == 0 ? bb->zero_row : row1 - wpr;
+    const uint64_t *row2 = i + 1 < bb->rows ? row1 + wpr : bb->zero_row;
+    const uint64_t *row3 = i + 2 < bb->rows ? row1 + 2 * wpr : bb->zero_row;
+    uint64_t *top = bb->next + ( size_t )i * wpr;
+    uint64_t *bottom = i + 1 < bb->rows ? top + wpr : NULL;
+    uint64_t p0 = 0, p1 = 0, p2 = 0, p3 = 0;
+    uint64_t c0 = row0[0], c1 = row1[0], c2 = row2[0], c3 = row3[0];
+    for ( int w = 0; w < wpr; w++ )
+    {
+        uint64_t n0 = 0, n1 = 0, n2 = 0, n3 = 0;
+        if ( w + 1 < wpr )
+        {
+            n0 = row0[w + 1];
+            n1 = row1[w + 1];
+            n2 = row2[w + 1];
+            n3 = row3[w + 1];
+        }
+        // Bit k of a window is column k - 1 of the word, so the square of columns j - 1 to j + 2 starts at bit j
+        uint64_t l0 = ( c0 << 1 ) | ( p0 >> 63 ), l1 = ( c1 << 1 ) | ( p1 >> 63 );
+        uint64_t l2 = ( c2 << 1 ) | ( p2 >> 63 ), l3 = ( c3 << 1 ) | ( p3 >> 63 );
+        uint64_t upper = 0, lower = 0;
+        for ( int s = 0; s < CELLS_PER_WORD - 2; s += 2 )
+        {
+            uint64_t block = table[get_square( l0, l1, l2, l3, s )];
+            upper |= ( block & 3 ) << s;
+            lower |= ( block >> 2 ) << s;
+        }
+        // The last block of the word reaches column 0 of the next word
+        uint64_t block = table[get_square( ( l0 >> 62 ) | ( ( ( c0 >> 63 ) | ( n0 << 1 ) ) << 2 ),
+            ( l1 >> 62 ) | ( ( ( c1 >> 63 ) | ( n1 << 1 ) ) << 2 ),
+            ( l2 >> 62 ) | ( ( ( c2 >> 63 ) | ( n2 << 1 ) ) << 2 ),
+            ( l3 >> 62 ) | ( ( ( c3 >> 63 ) | ( n3 << 1 ) ) << 2 ), 0 )];
+        upper |= ( block & 3 ) << 62;
+        lower |= ( block >> 2 ) << 62;
+        if ( w == wpr - 1 )
+        {
+            upper &= mask;
+            lower &= mask;
+        }
+        top[w] = upper;
+        if ( bottom != NULL )
+            bottom[w] = lower;
+        p0 = c0; p1 = c1; p2 = c2; p3 = c3;
+        c0 = n0; c1 = n1; c2 = n2; c3 = n3;
+    }
+}
+
+
+int init_lookup_table( LookupTable *table, uint32_t rule )
+{
+    if ( table == NULL )
+        return EXIT_FAILURE;
+    if ( table->next == NULL )
+    {
+        table->next = ( uint8_t* )malloc( LOOKUP_ENTRIES );
+        if ( table->next == NULL )
+        {
+            fprintf( stderr, "[Err] Unable to allocate the lookup table\n" );
+            return EXIT_FAILURE;
+        }
+    }
+    for ( unsigned square = 0; square < LOOKUP_ENTRIES; square++ )
+    {
+        table->next[square] = ( uint8_t )( get_square_cell( rule, square, 1, 1 ) |
+            ( get_square_cell( rule, square, 1, 2 ) << 1 ) |
+            ( get_square_cell( rule, square, 2, 1 ) << 2 ) |
+            ( get_square_cell( rule, square, 2, 2 ) << 3 ) );
+    }
+    table->rule = rule;
+    table->builds++;
+    return EXIT_SUCCESS;
+}
+
+void free_lookup_table( LookupTable *table )
+{
+    if ( table == NULL )
+        return;
+    free( table->next );
+    table->next = NULL;
+}
+
+int update_next_generation_lookup( BitBoard *bb, LookupTable *table )
+{
+    if ( bb == NULL || bb->cells == NULL || table == NULL )
+        return EXIT_FAILURE;
+    if ( ( table->next == NULL || table->rule != bb->rule ) && init_lookup_table( table, bb->rule ) == EXIT_FAILURE )
+        return EXIT_FAILURE;
+    for ( int i = 0; i < bb->rows; i += 2 )
+        step_row_pair( bb, table->next, i );
+    swap_bitboard( bb );
+    return EXIT_SUCCESS;
+}
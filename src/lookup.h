@@ -0,0 +1,80 @@
+/**
+* @file: lookup.h
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file contains the function prototypes of the lookup table engine
+* The next generation of a 2x2 block only depends on the 4x4 square around it, so the
+* 16 cells of the square are used as the index of a table that holds the 4 cells of the
+* block. The bit-packed board is walked two rows and two columns at a time, one lookup
+* per block and no neighbour is counted. The table is built again when the rule changes.
+**/
+
+
+#ifndef LOOKUP_H
+#define LOOKUP_H
+
+
+/** Include all the libraries **/
+#include <stdint.h>
+#include "bitboard.h"
+
+
+/** Define all the marcos of the lookup table **/
+#define LOOKUP_ENTRIES 65536    // One entry for each 4x4 square, 2^16
+
+
+/** define all the structs used by the lookup table engine **/
+typedef struct
+{
+    uint32_t rule;          // The rule the table was built for
+    uint8_t *next;          // The next 2x2 block of each 4x4 square, LOOKUP_ENTRIES entries
+    size_t builds;          // The number of times the table was built
+} LookupTable;
+
+
+/** Declare all the function prototypes **/
+/* Build the table of a rule
+    * Bit 4 * r + c of an index is row r and column c of the square, bits 0 and 1 of an entry are
+    * the cells at (1, 1) and (1, 2) of the square and bits 2 and 3 the cells at (2, 1) and (2, 2)
+    *
+    * @param table: the table to be built, its memory is allocated the first time
+    * @param rule: the rule, see rule.h
+    *
+    * @return: EXIT_SUCCESS if the table is built successfully, EXIT_FAILURE otherwise
+*/
+int init_lookup_table( LookupTable *table, uint32_t rule );
+
+/* Free the memory held by a table
+    *
+    * @param table: the table to be freed
+    *
+    * @return: none
+*/
+void free_lookup_table( LookupTable *table );
+
+/* Update the bit-packed board to the next generation, one 2x2 block at a time
+    * The result is the same as update_next_generation_bitboard, the table is built again first
+    * if the rule of the board is not the rule of the table
+    *
+    * @param bb: the bit-packed board to be updated
+    * @param table: the table
+    *
+    * @return: EXIT_SUCCESS if the board is updated successfully, EXIT_FAILURE otherwise
+*/
+int update_next_generation_lookup( BitBoard *bb, LookupTable *table );
+
+
+#endif
@@ -22,20 +22,119 @@
 /** Head files **/
 #include "game.h"
 #include "util.h"
+#include "hud.h"
+#include "simulation.h"
+#include "binfile.h"
+#include "pattern.h"
+#include "autosave.h"
+#include "profiler.h"
 
 /** Program parameters **/
 int WINDOW_WIDTH = 640;
 int WINDOW_HEIGHT = 640;
+#define USAGE "Usage: ./build/debug/exe <config_file> <data_file> [--turbo <gen/s|max>] " \
+    "[--autosave-every <generations>] [--autosave-interval <seconds>] [--rule <B3/S23>] " \
+    "[--boundary <dead|torus|klein>] [--frame-log <file.csv>]\n"
+#define MIN_TURBO_RATE 50               // The lowest target of turbo mode, one generation every MIN_DELAY
+#define MAX_TURBO_RATE 52428800         // The highest target of turbo mode, above it the rate is unlimited
+#define OVERLAY_LINE 18                 // The height of a line of the frame time overlay
+#define OVERLAY_WIDTH 380               // The width of the frame time overlay
+#define OVERLAY_REFRESH 500             // The milliseconds between two updates of the frame time overlay
 
 
+/* Parse the target rate of turbo mode from a command line argument
+    *
+    * @param text: the argument, a number of generations per second or "max"
+    *
+    * @return: the rate, SIM_RATE_UNLIMITED for "max", 0 if the argument is not a valid rate
+*/
+static long parse_rate( const char *text )
+{
+    char *end;
+    if ( strcmp( text, "max" ) == 0 )
+        return SIM_RATE_UNLIMITED;
+    long rate = strtol( text, &end, 10 );
+    if ( *text == '\0' || *end != '\0' || rate < MIN_TURBO_RATE || rate > MAX_TURBO_RATE )
+        return 0;
+    return rate;
+}
+
 int main( int argc, char** argv )
 {
     // Read command line arguments
-    if ( argc != 3 )
+    long rate = SIM_RATE_UNLIMITED;    // The target of turbo mode, kept while it is off
+    int turbo = FALSE;                  // TRUE while the generations run in batches at the target rate
+    long autosave_every = 0;            // The generations between two autosaves, 0 if they are not counted
+    long autosave_interval = AUTOSAVE_DEFAULT_SECONDS;  // The seconds between two autosaves, 0 if they are not timed
+    uint32_t rule = RULE_CONWAY;        // The rule given on the command line
+    int has_rule = FALSE;               // TRUE if the rule of the configuration is overridden, it is saved with the board
+    int boundary = -1;                  // The boundary given on the command line, -1 to keep the one of the configuration
+    char *frame_log = NULL;             // The CSV file the time of every phase of every frame is written to
+    if ( argc < 3 )
     {
-        printf( "Usage: ./build/debug/exe <config_file> <data_file>\n" );
+        printf( USAGE );
         return EXIT_FAILURE;
     }
+    for ( int i = 3; i < argc; i += 2 )
+    {
+        char *end;
+        if ( i + 1 >= argc )
+        {
+            printf( USAGE );
+            return EXIT_FAILURE;
+        }
+        if ( strcmp( argv[i], "--turbo" ) == 0 )
+        {
+            rate = parse_rate( argv[i + 1] );
+            if ( rate == 0 )
+            {
+                fprintf( stderr, "[Err] The turbo rate has to be max or between %d and %d\n", MIN_TURBO_RATE, MAX_TURBO_RATE );
+                return EXIT_FAILURE;
+            }
+            turbo = TRUE;
+        }
+        else if ( strcmp( argv[i], "--rule" ) == 0 )
+        {
+            if ( parse_rule( argv[i + 1], &rule ) == EXIT_FAILURE )
+                return EXIT_FAILURE;
+            has_rule = TRUE;
+        }
+        else if ( strcmp( argv[i], "--boundary" ) == 0 )
+        {
+            boundary = parse_boundary_mode( argv[i + 1] );
+            if ( boundary < 0 )
+            {
+                fprintf( stderr, "[Err] The boundary has to be dead, torus or klein: %s\n", argv[i + 1] );
+                return EXIT_FAILURE;
+            }
+        }
+        else if ( strcmp( argv[i], "--frame-log" ) == 0 )
+        {
+            frame_log = argv[i + 1];
+        }
+        else if ( strcmp( argv[i], "--autosave-every" ) == 0 || strcmp( argv[i], "--autosave-interval" ) == 0 )
+        {
+            long value = strtol( argv[i + 1], &end, 10 );
+            if ( argv[i + 1][0] == '\0' || *end != '\0' || value < 0 )
+            {
+                fprintf( stderr, "[Err] %s has to be followed by a number that is not negative\n", argv[i] );
+                return EXIT_FAILURE;
+            }
+            if ( strcmp( argv[i], "--autosave-every" ) == 0 )
+                autosave_every = value;
+            else
+                autosave_interval = value;
+        }
+        else
+        {
+            printf( USAGE );
+            return EXIT_FAILURE;
+        }
+    }
+    // Every phase of the drawn frames is timed, the times are shown with F3
+    FrameProfiler profiler;
+    if ( init_frame_profiler( &profiler, frame_log ) == EXIT_FAILURE )
+        return EXIT_FAILURE;
     char *config_file = malloc( strlen( argv[1] ) + 1 );
     char *data_file = malloc( strlen( argv[2] ) + 1 );
     strcpy( config_file, argv[1] );
@@ -56,7 +155,20 @@ int main( int argc, char** argv )
     // Initialize the board
     Board *board;
     board = malloc( sizeof( Board ) );
-    int code = init_board_from_file( config_file, data_file, board );
+    uint64_t first_generation = 0;     // The generation the board was saved at
+    int code;
+    if ( is_bin_file( data_file ) )
+        code = load_board_from_bin( data_file, board, &first_generation );
+    else if ( get_pattern_format( data_file ) != PATTERN_NONE )
+    {
+        // A pattern is placed into an empty board of the configured size
+        code = read_config_file( config_file, board );
+        if ( code == EXIT_SUCCESS && ( code = alloc_board( board ) ) == EXIT_SUCCESS &&
+            ( code = read_pattern_file( data_file, board, 0, 0, NULL ) ) == EXIT_FAILURE )
+            free_board( board );
+    }
+    else
+        code = init_board_from_file( config_file, data_file, board );
     if ( code == EXIT_FAILURE )
     {
         free( config_file );
@@ -68,6 +180,10 @@ int main( int argc, char** argv )
     {
         init_board_by_user( board );
     }
+    if ( has_rule )
+        board->rule = rule;
+    if ( boundary >= 0 )
+        board->boundary = ( BoundaryMode )boundary;
 
     // Initialize the view window
     Window view;
@@ -102,7 +218,7 @@ int main( int argc, char** argv )
         SDL_SetWindowIcon( window, IMG_Load( "resources/images/life.png" ) );
 
         // Create renderer
-        Uint32 render_flags = SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC;
+        Uint32 render_flags = SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC | SDL_RENDERER_TARGETTEXTURE;
         SDL_Renderer *rend = SDL_CreateRenderer( window, -1, render_flags );
         if ( !rend )
         {
@@ -112,10 +228,28 @@ int main( int argc, char** argv )
             return EXIT_FAILURE;
         }
 
+        // Create the textures the board is drawn into
+        BoardTexture board_texture;
+        if ( init_board_texture( &board_texture, &view, rend ) == EXIT_FAILURE )
+        {
+            SDL_DestroyRenderer( rend );
+            SDL_DestroyWindow( window );
+            SDL_Quit();
+            return EXIT_FAILURE;
+        }
+
+        // Load every image once, the render loop only copies the resident textures
+        AssetCache assets;
+        init_asset_cache( &assets, rend, ASSET_DIRECTORY );
+        int play_button = get_asset( &assets, "play.svg" );
+        int pause_button = get_asset( &assets, "pause.svg" );
+
         // Create font rend
         if ( TTF_Init() == -1 )
         {
             fprintf( stderr, "[Err] Error trying to initialize TTF: %s\n", SDL_GetError() );
+            free_board_texture( &board_texture );
+            free_asset_cache( &assets );
             SDL_DestroyRenderer( rend );
             SDL_DestroyWindow( window );
             SDL_Quit();
@@ -124,52 +258,110 @@ int main( int argc, char** argv )
         TTF_Font* smooth_operator = TTF_OpenFont( "resources/fonts/Formula1-Regular.ttf", 16 );
         SDL_Color Gray = {80, 80, 80, 255};
 
+        // Rasterise the glyphs of the HUD once, the font is not needed afterwards
+        Hud hud;
+        Hud overlay;        // The frame times, one line for each phase
+        int overlay_width = view.window_width < OVERLAY_WIDTH ? view.window_width : OVERLAY_WIDTH;
+        int overlay_height = FRAME_PHASE_COUNT * OVERLAY_LINE + 8;
+        int hud_code = init_hud( &hud, rend, smooth_operator, Gray, view.window_width, HUD_HEIGHT );
+        if ( hud_code == EXIT_SUCCESS &&
+            ( hud_code = init_hud( &overlay, rend, smooth_operator, Gray, overlay_width, overlay_height ) ) == EXIT_FAILURE )
+            free_hud( &hud );
+        if ( smooth_operator != NULL )
+            TTF_CloseFont( smooth_operator );
+        if ( hud_code == EXIT_FAILURE )
+        {
+            free_board_texture( &board_texture );
+            free_asset_cache( &assets );
+            TTF_Quit();
+            SDL_DestroyRenderer( rend );
+            SDL_DestroyWindow( window );
+            SDL_Quit();
+            return EXIT_FAILURE;
+        }
+
         // Create event loop
         SDL_Event eve;
         int quit = FALSE;
         int pause = TRUE;           // Always pause the game at the beginning
-        int last_update_tick = 0;   // The tick of the last update, used to control the update frequency
         int x, y;                   // The position of the mouse
-        int iteration = 0;         // The number of iterations
-        char *str = malloc( sizeof( char ) * 50 );      // The iteration string
-        char *str_1 = malloc( sizeof( char ) * 50 );    // The delay string
-        char *str_2 = malloc( sizeof( char ) * 50 );    // The input string
+        long iteration = 0;         // The number of iterations
+        long achieved = 0;          // The generations per second of the simulation thread
+        int redraw = TRUE;          // FALSE while nothing on the screen has changed since the last frame
+        ChangeSet changes;          // The tiles of the board changed since the last frame
+        Simulation sim;             // The generations are run on their own thread
+        Snapshot latest;            // The generation number and state of the last snapshot received
+        AutoSave autosave;          // The board is saved by its own thread while the game goes on
+        int unsaved = FALSE;        // TRUE while the board has changed since the last autosave
+        long saved_iteration = 0;   // The iteration of the last autosave
+        Uint32 saved_ticks = SDL_GetTicks();    // The time of the last autosave
+        int show_overlay = FALSE;   // TRUE while the frame times are shown
+        Uint32 overlay_ticks = 0;   // The time the frame times were last written into the overlay
+        if ( init_change_set( &changes, board->rows, board->columns ) == EXIT_FAILURE )
+            quit = TRUE;
+        // The bit-packed engine only has dead edges, the vectorized one wraps them through its halo
+        else if ( start_simulation( &sim, board, board->boundary == BOUNDARY_DEAD ? ENGINE_BITBOARD : ENGINE_SIMD ) == EXIT_FAILURE )
+        {
+            free_change_set( &changes );
+            quit = TRUE;
+        }
+        else if ( start_autosave( &autosave, config_file, data_file, board ) == EXIT_FAILURE )
+        {
+            stop_simulation( &sim );
+            free_change_set( &changes );
+            quit = TRUE;
+        }
+        else
+        {
+            if ( pre > 0 )
+                send_simulation_command( &sim, SIM_SET_LIMIT, 0, 0, pre );
+            if ( turbo )
+                send_simulation_command( &sim, SIM_SET_RATE, 0, 0, rate );
+        }
+        int running = !quit;        // TRUE while the simulation thread has to be stopped
         while ( !quit )
         {
-            // Do some string works here
-            sprintf( str, "Iteration - %d", iteration );
-            sprintf( str_1, "Delay - %d", board->delay );
-            sprintf( str_2, "Pre - %d", pre );
+            begin_frame( &profiler );
+            // The HUD strings are only formatted and laid out again when their values change
+            set_hud_value( &hud, 0, 15, HUD_HEIGHT - 28, "Iteration - ", iteration );
+            // Turbo mode is not paced by the delay, so the achieved rate is shown instead
+            if ( turbo )
+                set_hud_value( &hud, 1, 165, HUD_HEIGHT - 28, "Gen/s - ", achieved );
+            else
+                set_hud_value( &hud, 1, 165, HUD_HEIGHT - 28, "Delay - ", board->delay );
+            set_hud_value( &hud, 2, 300, HUD_HEIGHT - 28, "Pre - ", pre );
+            end_frame_phase( &profiler, FRAME_HUD );
             // Listen to events
             while ( SDL_PollEvent( &eve ) )
             {
+                redraw = TRUE;
                 // Kill the main thread if the close button is clicked
                 if ( eve.type == SDL_QUIT )
                 {
-                    write_back_to_file( config_file, data_file, board );
+                    stop_autosave( &autosave );
+                    save_board_file( config_file, data_file, board, first_generation + iteration );
                     quit = TRUE;
                 }
                 // Mouse functionalities
                 else if ( eve.button.button == SDL_BUTTON_LEFT || eve.button.button == SDL_BUTTON_RIGHT )
                 {
-                    x = eve.button.x / ( view.cell_size );
-                    y = eve.button.y / ( view.cell_size );
+                    x = view.camera_x + eve.button.x / ( view.cell_size );
+                    y = view.camera_y + eve.button.y / ( view.cell_size );
                     // The mouse clicks on the board
-                    if ( x >= 0 && x < board->columns && y >= 0 && y < board->rows )
+                    if ( eve.button.y < view.window_height - HUD_HEIGHT &&
+                        x >= 0 && x < board->columns && y >= 0 && y < board->rows )
                     {
                         pause = TRUE;
                         if ( eve.button.button == SDL_BUTTON_LEFT)  // Add new living cells
                             board->grid[y][x] = 1;
                         else if ( eve.button.button == SDL_BUTTON_RIGHT )   // Remove living cells
                             board->grid[y][x] = 0;
-                        // Remember to rerender everything on the screen if something is changed
-                        SDL_RenderClear( rend );
-                        draw_board( board, &view, rend );
-                        render_text( rend, smooth_operator, Gray, str, 15, view.window_height - 28 );
-                        render_text( rend, smooth_operator, Gray, str_1, 165, view.window_height - 28 );
-                        render_text( rend, smooth_operator, Gray, str_2, 300, view.window_height - 28 );
-                        render_button( rend, "resources/images/play.svg", view.window_width - 36, view.window_height - 32 );
-                        SDL_RenderPresent( rend );
+                        // Only the tile of the edited cell is drawn again
+                        mark_cell_changed( &changes, y, x );
+                        unsaved = TRUE;
+                        // The edit is shown at once and applied by the simulation thread before its next generation
+                        send_simulation_command( &sim, SIM_PAUSE, 0, 0, 0 );
+                        send_simulation_command( &sim, SIM_SET_CELL, y, x, board->grid[y][x] );
                     }
                     // The mouse clicks on the play button
                     else if ( eve.type == SDL_MOUSEBUTTONDOWN && eve.button.x >= view.window_width - 36 && 
@@ -177,8 +369,20 @@ int main( int argc, char** argv )
                         eve.button.y <= view.window_height - 8 )
                     {
                         pause = !pause;
+                        send_simulation_command( &sim, pause ? SIM_PAUSE : SIM_RESUME, 0, 0, 0 );
                     }
                 }
+                // The HUD texture is lost when the render targets are reset
+                else if ( eve.type == SDL_RENDER_TARGETS_RESET )
+                {
+                    hud.dirty = TRUE;
+                    overlay.dirty = TRUE;
+                }
+                // Zoom the view with the mouse wheel
+                else if ( eve.type == SDL_MOUSEWHEEL )
+                {
+                    zoom_view( &view, board, eve.wheel.y > 0 );
+                }
                 // Keyboard functionalities
                 else if ( eve.type == SDL_KEYDOWN )
                 {
@@ -186,81 +390,189 @@ int main( int argc, char** argv )
                     {
                         case SDL_SCANCODE_SPACE:
                             pause = !pause;
+                            send_simulation_command( &sim, pause ? SIM_PAUSE : SIM_RESUME, 0, 0, 0 );
                             break;
                         case SDL_SCANCODE_C:
                             pause = TRUE;
                             iteration = 0;
+                            first_generation = 0;
+                            saved_iteration = 0;
+                            unsaved = TRUE;
                             clear_all_cells( board );
-                            // Remember to rerender everything on the screen if something is changed
-                            SDL_RenderClear( rend );
-                            draw_board( board, &view, rend );
-                            render_text( rend, smooth_operator, Gray, str, 15, view.window_height - 28 );
-                            render_text( rend, smooth_operator, Gray, str_1, 165, view.window_height - 28 );
-                            render_text( rend, smooth_operator, Gray, str_2, 300, view.window_height - 28 );
-                            render_button( rend, "resources/images/play.svg", view.window_width - 36, view.window_height - 32 );
-                            SDL_RenderPresent( rend );
+                            mark_all_changed( &changes );
+                            send_simulation_command( &sim, SIM_CLEAR, 0, 0, 0 );
+                            break;
+                        case SDL_SCANCODE_G:
+                            board_texture.show_grid = !board_texture.show_grid;
+                            break;
+                        case SDL_SCANCODE_F3:
+                            show_overlay = !show_overlay;
+                            overlay_ticks = 0;
                             break;
                         case SDL_SCANCODE_ESCAPE:
-                            write_back_to_file( config_file, data_file, board );
+                            stop_autosave( &autosave );
+                            save_board_file( config_file, data_file, board, first_generation + iteration );
                             quit = TRUE;
                             break;
+                        // Move the camera around large boards
+                        case SDL_SCANCODE_W:
+                            move_camera( &view, board, 0, -view.movement_speed_in_cells );
+                            break;
+                        case SDL_SCANCODE_S:
+                            move_camera( &view, board, 0, view.movement_speed_in_cells );
+                            break;
+                        case SDL_SCANCODE_A:
+                            move_camera( &view, board, -view.movement_speed_in_cells, 0 );
+                            break;
+                        case SDL_SCANCODE_D:
+                            move_camera( &view, board, view.movement_speed_in_cells, 0 );
+                            break;
+                        case SDL_SCANCODE_T:
+                            turbo = !turbo;
+                            send_simulation_command( &sim, SIM_SET_RATE, 0, 0, turbo ? rate : 0 );
+                            break;
+                        // In turbo mode the target rate is doubled or halved, past the highest one it is unlimited
                         case SDL_SCANCODE_UP:
+                            if ( turbo )
+                            {
+                                if ( rate != SIM_RATE_UNLIMITED )
+                                    rate = rate * 2 <= MAX_TURBO_RATE ? rate * 2 : SIM_RATE_UNLIMITED;
+                                send_simulation_command( &sim, SIM_SET_RATE, 0, 0, rate );
+                                break;
+                            }
                             if ( board->delay - 20 >= MIN_DELAY )
                                 board->delay -= 20;
+                            send_simulation_command( &sim, SIM_SET_DELAY, 0, 0, board->delay );
                             break;
                         case SDL_SCANCODE_DOWN:
+                            if ( turbo )
+                            {
+                                if ( rate == SIM_RATE_UNLIMITED )
+                                    rate = MAX_TURBO_RATE;
+                                else if ( rate / 2 >= MIN_TURBO_RATE )
+                                    rate /= 2;
+                                send_simulation_command( &sim, SIM_SET_RATE, 0, 0, rate );
+                                break;
+                            }
                             if ( board->delay + 20 <= MAX_DELAY )
                                 board->delay += 20;
+                            send_simulation_command( &sim, SIM_SET_DELAY, 0, 0, board->delay );
                             break;
                         default:
                             break;
                     }
                 }
             }
-            // Update the board if the game is not paused, control the frequency of updates
-            if ( !pause && !( ( SDL_GetTicks( ) - last_update_tick ) < board->delay ) )
+            end_frame_phase( &profiler, FRAME_EVENTS );
+            // Show the latest generation completed by the simulation thread, never wait for one
+            if ( !quit && receive_snapshot( &sim, board, &changes, &latest ) )
             {
-                update_next_generation( board );
-                // Update the current tick to the last update tick
-                last_update_tick = SDL_GetTicks();
-                iteration++;
-                if ( iteration == pre)
-                    pause = TRUE;
+                redraw = TRUE;
+                iteration = ( long )latest.generation;
+                pause = latest.paused;
+                achieved = ( long )( latest.rate + 0.5 );
+                unsaved = unsaved || iteration != saved_iteration;
             }
-            // Do the drawing and rendering
+            end_frame_phase( &profiler, FRAME_SNAPSHOT );
+            // The board is copied for the autosave thread, a save that is still being written is never waited for
+            if ( !quit && unsaved && ( ( autosave_every > 0 && iteration - saved_iteration >= autosave_every ) ||
+                ( autosave_interval > 0 && SDL_GetTicks() - saved_ticks >= ( Uint32 )autosave_interval * 1000 ) ) &&
+                request_autosave( &autosave, board, first_generation + iteration ) == EXIT_SUCCESS )
+            {
+                unsaved = FALSE;
+                saved_iteration = iteration;
+                saved_ticks = SDL_GetTicks();
+            }
+            end_frame_phase( &profiler, FRAME_AUTOSAVE );
+            // A paused board that nothing happened to keeps the last frame on the screen
+            if ( !redraw )
+            {
+                SDL_Delay( 1 );
+                continue;
+            }
+            redraw = FALSE;
+            // Do the drawing and rendering, a frame that is not drawn is not recorded
             SDL_SetRenderDrawColor( rend, BACKGROUND_R, BACKGROUND_G, BACKGROUND_B, 255 );
             SDL_RenderClear( rend );
-            draw_board( board, &view, rend );
-            render_text( rend, smooth_operator, Gray, str, 15, view.window_height - 28 );
-            render_text( rend, smooth_operator, Gray, str_1, 165, view.window_height - 28 );
-            render_text( rend, smooth_operator, Gray, str_2, 300, view.window_height - 28 );
+            draw_board( board, &view, &board_texture, &changes, rend );
+            end_frame_phase( &profiler, FRAME_BOARD );
+            draw_hud( &hud, rend, 0, view.window_height - HUD_HEIGHT );
+            // The frame times sit above the status bar, they are only written again twice a second to stay readable
+            if ( show_overlay )
+            {
+                if ( overlay_ticks == 0 || SDL_GetTicks() - overlay_ticks >= OVERLAY_REFRESH )
+                {
+                    for ( int i = 0; i < FRAME_PHASE_COUNT; i++ )
+                    {
+                        FrameStats stats;
+                        char line[HUD_TEXT_LENGTH];
+                        get_frame_stats( &profiler, ( FramePhase )i, &stats );
+                        snprintf( line, sizeof( line ), "%-8s min %.2f  avg %.2f  p99 %.2f ms",
+                            get_frame_phase_name( ( FramePhase )i ), stats.min, stats.average, stats.p99 );
+                        set_hud_text( &overlay, i, 8, 4 + i * OVERLAY_LINE, line );
+                    }
+                    overlay_ticks = SDL_GetTicks();
+                }
+                SDL_Rect background = { 0, view.window_height - HUD_HEIGHT - overlay_height, overlay_width, overlay_height };
+                SDL_SetRenderDrawColor( rend, BACKGROUND_R, BACKGROUND_G, BACKGROUND_B, 255 );
+                SDL_RenderFillRect( rend, &background );
+                draw_hud( &overlay, rend, background.x, background.y );
+            }
+            end_frame_phase( &profiler, FRAME_HUD );
             if ( pause )
             {
                 SDL_SetWindowTitle( window, window_title_paused );
-                render_button( rend, "resources/images/play.svg", view.window_width - 36, view.window_height - 32 );
+                render_button( &assets, play_button, view.window_width - 36, view.window_height - 32 );
             }
             else
             {
                 SDL_SetWindowTitle( window, window_title);
-                render_button( rend, "resources/images/pause.svg", view.window_width - 36, view.window_height - 32 );
+                render_button( &assets, pause_button, view.window_width - 36, view.window_height - 32 );
             }
+            end_frame_phase( &profiler, FRAME_BUTTONS );
             SDL_RenderPresent( rend );
+            end_frame_phase( &profiler, FRAME_PRESENT );
+            end_frame( &profiler );
+            // The overlay is kept up to date while it is shown, even if nothing else changes
+            if ( show_overlay && SDL_GetTicks() - overlay_ticks >= OVERLAY_REFRESH )
+                redraw = TRUE;
         }
 
         // Free the allocated memory
+        if ( running )
+        {
+            stop_simulation( &sim );
+            free_change_set( &changes );
+            stop_autosave( &autosave );
+            if ( autosave.saves > 0 || autosave.failures > 0 )
+                printf( "[!] %zu autosaves were written, %zu failed and %zu were skipped\n",
+                    autosave.saves, autosave.failures, autosave.skipped );
+        }
+        free_board( board );
         free( board );
         free( config_file );
         free( data_file );
         free( window_title );
         free( window_title_paused );
-        free( str );
-        free( str_1 );
-        free( str_2 );
 
         // Clean SDL resources before exiting
+        free_board_texture( &board_texture );
+        free_hud( &hud );
+        free_hud( &overlay );
+        printf( "[!] %zu images were loaded from the disk\n", assets.disk_loads );
+        free_asset_cache( &assets );
+        TTF_Quit();
         SDL_DestroyRenderer ( rend );
         SDL_DestroyWindow( window );
         SDL_Quit();
+        if ( profiler.frames > 0 )
+        {
+            FrameStats stats;
+            get_frame_stats( &profiler, FRAME_TOTAL, &stats );
+            printf( "[!] %llu frames were drawn, the last ones took %.2f ms on average and %.2f ms at the 99th percentile\n",
+                ( unsigned long long )profiler.frames, stats.average, stats.p99 );
+        }
+        free_frame_profiler( &profiler );
         printf( "[!] Program terminated\n" );
     }
     return EXIT_SUCCESS;
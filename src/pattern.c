@@ -0,0 +1,472 @@
+/**
+* @file: pattern.c
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file contains all the functions of the pattern files
+* All the according function prototypes are defined in pattern.h
+**/
+
+/** Head files **/
+#include <ctype.h>
+#include "pattern.h"
+
+
+/** The limits of the parser **/
+#define PATTERN_HEADER_LENGTH 256       // The longest RLE header line that is kept, the rest of it is ignored
+#define PATTERN_MAX_NUMBER 1000000000L  // The largest run length or coordinate accepted
+
+
+/** The states of the parser **/
+typedef enum
+{
+    PARSE_LINE_START,   // At the start of a line
+    PARSE_COMMENT,      // In a line starting with #, skipped up to the end of the line
+    PARSE_HEADER,       // In the "x = ..., y = ..." line of an RLE file
+    PARSE_BODY,         // In the cells of the pattern
+    PARSE_DONE          // After the ! that ends an RLE pattern
+} ParseState;
+
+/** The state of the parser, it is kept between the blocks of the file **/
+typedef struct
+{
+    PatternFormat format;               // The format of the file
+    ParseState state;                   // What the parser is in
+    Board *board;                       // The board that receives the cells
+    long origin_row;                    // The row of the origin of the pattern in the board
+    long origin_col;                    // The column of the origin of the pattern in the board
+    PatternInfo info;                   // The size and number of cells of the pattern
+    char line_text[PATTERN_HEADER_LENGTH];  // The header or comment line read so far
+    int line_length;                    // The number of characters in line_text
+    long x;                             // The column of the next RLE cell from the origin
+    long y;                             // The row of the next RLE cell from the origin
+    long number;                        // The run length or coordinate being read
+    int digits;                         // The number of digits of number read so far
+    int negative;                       // 1 if the coordinate being read has a minus sign
+    long coordinates[2];                // The coordinates of the Life 1.06 line read so far
+    int coordinate_count;               // The number of coordinates in the Life 1.06 line
+    size_t line;                        // The line of the file, from 1
+    size_t column;                      // The column of the line, from 1
+} PatternParser;
+
+
+/* Set a run of living cells starting at a cell of the pattern, the cells outside the board are counted as clipped */
+static void place_run( PatternParser *p, long y, long x, long length )
+{
+    long row = p->origin_row + y, first = p->origin_col + x, last = first + length;
+    if ( row < 0 || row >= p->board->rows || last <= 0 || first >= p->board->columns )
+    {
+        p->info.clipped += length;
+        return;
+    }
+    first = first > 0 ? first : 0;
+    last = last < p->board->columns ? last : p->board->columns;
+    memset( p->board->grid[row] + first, 1, last - first );
+    p->info.cells += last - first;
+    p->info.clipped += length - ( last - first );
+}
+
+/* Report a malformed pattern with the place of the character */
+static int parse_error( PatternParser *p, const char *file, const char *message, int c )
+{
+    fprintf( stderr, "[Err] %s:%zu:%zu: %s '%c'\n", file, p->line, p->column, message, isprint( c ) ? c : '?' );
+    return EXIT_FAILURE;
+}
+
+/* Take the header line of an RLE file, the rule is only reported, the board keeps its own */
+static void parse_rle_header( PatternParser *p )
+{
+    char rule[RULE_TEXT_LENGTH];
+    p->line_text[p->line_length] = '\0';
+    sscanf( p->line_text, "x = %ld , y = %ld", &p->info.width, &p->info.height );
+    const char *text = strstr( p->line_text, "rule" );
+    if ( text != NULL && sscanf( text, "rule = %23[^,: \t\r\n]", rule ) == 1 && parse_rule( rule, &p->info.rule ) == EXIT_FAILURE )
+        p->info.rule = RULE_CONWAY;
+}
+
+/* Take a comment line, an RLE "#R x y" comment moves the origin of the pattern */
+static void parse_comment( PatternParser *p )
+{
+    long x, y;
+    p->line_text[p->line_length] = '\0';
+    if ( p->format == PATTERN_RLE && sscanf( p->line_text, "#R %ld %ld", &x, &y ) == 2 &&
+        labs( x ) <= PATTERN_MAX_NUMBER && labs( y ) <= PATTERN_MAX_NUMBER )
+    {
+        p->origin_col += x;
+        p->origin_row += y;
+    }
+}
+
+/* Read one character of the cells of an RLE pattern */
+static int parse_rle_body( PatternParser *p, const char *file, int c )
+{
+    if ( isdigit( c ) )
+    {
+        p->number = p->number * 10 + ( c - '0' );
+        if ( p->number > PATTERN_MAX_NUMBER )
+            return parse_error( p, file, "run length too large at", c );
+        return EXIT_SUCCESS;
+    }
+    // A run length may be split from its tag by a new line
+    if ( isspace( c ) )
+        return EXIT_SUCCESS;
+    long run = p->number > 0 ? p->number : 1;
+    p->number = 0;
+    if ( c == 'b' || c == '.' )
+        p->x += run;
+    else if ( c == '$' )
+    {
+        p->y += run;
+        p->x = 0;
+    }
+    else if ( c == '!' )
+        p->state = PARSE_DONE;
+    else if ( isalpha( c ) )
+    {
+        // Every state other than dead is alive in a two state rule
+        place_run( p, p->y, p->x, run );
+        p->x += run;
+    }
+    else
+        return parse_error( p, file, "unexpected character", c );
+    return EXIT_SUCCESS;
+}
+
+/* Finish the coordinate being read of a Life 1.06 line */
+static int end_coordinate( PatternParser *p, const char *file, int c )
+{
+    if ( p->digits == 0 )
+    {
+        if ( p->negative )
+            return parse_error( p, file, "expected a digit before", c );
+        return EXIT_SUCCESS;
+    }
+    if ( p->coordinate_count == 2 )
+        return parse_error( p, file, "more than two coordinates at", c );
+    p->coordinates[p->coordinate_count++] = p->negative ? -p->number : p->number;
+    p->number = 0;
+    p->digits = 0;
+    p->negative = 0;
+    return EXIT_SUCCESS;
+}
+
+/* Read one character of the cells of a Life 1.06 pattern */
+static int parse_life106_body( PatternParser *p, const char *file, int c )
+{
+    if ( isdigit( c ) )
+    {
+        p->number = p->number * 10 + ( c - '0' );
+        p->digits++;
+        if ( p->number > PATTERN_MAX_NUMBER )
+            return parse_error( p, file, "coordinate too large at", c );
+        return EXIT_SUCCESS;
+    }
+    if ( c == '-' && p->digits == 0 && !p->negative )
+    {
+        p->negative = 1;
+        return EXIT_SUCCESS;
+    }
+    if ( !isspace( c ) )
+        return parse_error( p, file, "unexpected character", c );
+    if ( end_coordinate( p, file, c ) == EXIT_FAILURE )
+        return EXIT_FAILURE;
+    if ( c == '\n' )
+    {
+        if ( p->coordinate_count == 1 )
+            return parse_error( p, file, "expected two coordinates before", c );
+        if ( p->coordinate_count == 2 )
+            place_run( p, p->coordinates[1], p->coordinates[0], 1 );
+        p->coordinate_count = 0;
+    }
+    return EXIT_SUCCESS;
+}
+
+/* Feed a block of the file to the parser */
+static int parse_block( PatternParser *p, const char *file, const char *block, size_t length )
+{
+    for ( size_t i = 0; i < length && p->state != PARSE_DONE; i++ )
+    {
+        int c = ( unsigned char )block[i];
+        p->column++;
+        if ( c == '\r' )
+            continue;
+        switch ( p->state )
+        {
+            case PARSE_LINE_START:
+                p->line_length = 0;
+                if ( c == '#' )
+                    p->state = PARSE_COMMENT;
+                else if ( c == 'x' && p->format == PATTERN_RLE && p->info.width == 0 && p->x == 0 && p->y == 0 )
+                    p->state = PARSE_HEADER;
+                else
+                    p->state = PARSE_BODY;
+                if ( p->state != PARSE_BODY )
+                {
+                    p->line_text[p->line_length++] = ( char )c;
+                    break;
+                }
+                // The first character of a line of cells is read like the others
+                // fall through
+            case PARSE_BODY:
+                if ( ( p->format == PATTERN_RLE ? parse_rle_body( p, file, c ) : parse_life106_body( p, file, c ) ) == EXIT_FAILURE )
+                    return EXIT_FAILURE;
+                if ( c == '\n' && p->state == PARSE_BODY )
+                    p->state = PARSE_LINE_START;
+                break;
+            case PARSE_COMMENT:
+            case PARSE_HEADER:
+                if ( c != '\n' )
+                {
+                    if ( p->line_length < PATTERN_HEADER_LENGTH - 1 )
+                        p->line_text[p->line_length++] = ( char )c;
+                    break;
+                }
+                if ( p->state == PARSE_HEADER )
+                    parse_rle_header( p );
+                else
+                    parse_comment( p );
+                p->state = PARSE_LINE_START;
+                break;
+            case PARSE_DONE:
+                break;
+        }
+        if ( c == '\n' )
+        {
+            p->line++;
+            p->column = 0;
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+
+PatternFormat get_pattern_format( const char *file )
+{
+    if ( file == NULL )
+        return PATTERN_NONE;
+    size_t length = strlen( file );
+    if ( length > strlen( RLE_EXTENSION ) && strcmp( file + length - strlen( RLE_EXTENSION ), RLE_EXTENSION ) == 0 )
+        return PATTERN_RLE;
+    if ( length > strlen( LIFE106_EXTENSION ) && strcmp( file + length - strlen( LIFE106_EXTENSION ), LIFE106_EXTENSION ) == 0 )
+        return PATTERN_LIFE106;
+    return PATTERN_NONE;
+}
+
+int read_pattern_file( const char *file, Board *board, int row, int col, PatternInfo *info )
+{
+    if ( file == NULL || board == NULL || board->grid == NULL )
+        return EXIT_FAILURE;
+    FILE *fp = fopen( file, "rb" );
+    char *block = ( char* )malloc( PATTERN_BLOCK_SIZE );
+    if ( fp == NULL || block == NULL )
+    {
+        fprintf( stderr, File_IO_Err );
+        free( block );
+        if ( fp != NULL )
+            fclose( fp );
+        return EXIT_FAILURE;
+    }
+    PatternParser *p = ( PatternParser* )calloc( 1, sizeof( PatternParser ) );
+    if ( p == NULL )
+    {
+        fprintf( stderr, "[Err] Memory allocation failed\n" );
+        free( block );
+        fclose( fp );
+        return EXIT_FAILURE;
+    }
+    p->state = PARSE_LINE_START;
+    p->info.rule = RULE_CONWAY;
+    p->board = board;
+    p->origin_row = row;
+    p->origin_col = col;
+    p->line = 1;
+    int code = EXIT_SUCCESS;
+    size_t length;
+    while ( code == EXIT_SUCCESS && p->state != PARSE_DONE && ( length = fread( block, 1, PATTERN_BLOCK_SIZE, fp ) ) > 0 )
+    {
+        // The format is known from the first line of the file
+        if ( p->format == PATTERN_NONE )
+        {
+            size_t header = strlen( LIFE106_HEADER );
+            p->format = length >= header && memcmp( block, LIFE106_HEADER, header ) == 0 ? PATTERN_LIFE106 : PATTERN_RLE;
+            p->info.format = p->format;
+        }
+        code = parse_block( p, file, block, length );
+    }
+    // A Life 1.06 file does not have to end with a new line
+    if ( code == EXIT_SUCCESS && p->format == PATTERN_LIFE106 && p->state == PARSE_BODY )
+        code = parse_life106_body( p, file, '\n' );
+    if ( code == EXIT_SUCCESS && ferror( fp ) )
+    {
+        fprintf( stderr, File_IO_Err );
+        code = EXIT_FAILURE;
+    }
+    if ( code == EXIT_SUCCESS && p->info.clipped > 0 )
+        fprintf( stderr, "[!] %zu living cells of %s were outside the board\n", p->info.clipped, file );
+    if ( info != NULL )
+        *info = p->info;
+    free( p );
+    free( block );
+    fclose( fp );
+    return code;
+}
+
+
+/** The state of the RLE writer, lines are kept under PATTERN_LINE_LENGTH **/
+typedef struct
+{
+    FILE *fp;           // The file written
+    int line_length;    // The number of characters in the current line
+} RleWriter;
+
+/* Write a run of cells, the count is left out when it is 1 */
+static void write_run( RleWriter *w, long count, char tag )
+{
+    char text[24];
+    int length = count > 1 ? sprintf( text, "%ld%c", count, tag ) : sprintf( text, "%c", tag );
+    if ( w->line_length + length > PATTERN_LINE_LENGTH )
+    {
+        fputc( '\n', w->fp );
+        w->line_length = 0;
+    }
+    fputs( text, w->fp );
+    w->line_length += length;
+}
+
+/* Get the first and last living columns of a row, the last one is -1 for an empty row */
+static void find_living_span( const Cell *cells, int columns, int *first, int *last )
+{
+    const Cell *alive = memchr( cells, 1, columns );
+    *first = *last = -1;
+    if ( alive == NULL )
+        return;
+    *first = ( int )( alive - cells );
+    for ( *last = columns - 1; !cells[*last]; ( *last )-- );
+}
+
+int write_rle_file( const char *file, Board *board )
+{
+    if ( file == NULL || board == NULL || board->grid == NULL )
+        return EXIT_FAILURE;
+    // The pattern is the bounding box of the living cells
+    int top = -1, bottom = -1, left = board->columns, right = -1;
+    for ( int i = 0; i < board->rows; i++ )
+    {
+        int first, last;
+        find_living_span( board->grid[i], board->columns, &first, &last );
+        if ( last < 0 )
+            continue;
+        if ( top < 0 )
+            top = i;
+        bottom = i;
+        left = first < left ? first : left;
+        right = last > right ? last : right;
+    }
+    FILE *fp = fopen( file, "w" );
+    if ( fp == NULL )
+    {
+        fprintf( stderr, File_IO_Err );
+        return EXIT_FAILURE;
+    }
+    RleWriter w = { fp, 0 };
+    char rule[RULE_TEXT_LENGTH];
+    format_rule( board->rule, rule );
+    if ( top < 0 )
+    {
+        fprintf( fp, "x = 0, y = 0, rule = %s\n!\n", rule );
+        return fclose( fp ) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    // The place of the pattern in the board is kept in an XLife #R line
+    fprintf( fp, "#R %d %d\nx = %d, y = %d, rule = %s\n", left, top, right - left + 1, bottom - top + 1, rule );
+    long empty_rows = 0;
+    for ( int i = top; i <= bottom; i++ )
+    {
+        const Cell *cells = board->grid[i];
+        int first, last;
+        find_living_span( cells, board->columns, &first, &last );
+        if ( last < 0 )
+        {
+            empty_rows++;
+            continue;
+        }
+        // The end of the previous row and the empty rows after it are a single run
+        if ( i > top )
+            write_run( &w, empty_rows + 1, '$' );
+        empty_rows = 0;
+        int j = left;
+        while ( j <= last )
+        {
+            const Cell *alive = memchr( cells + j, 1, last + 1 - j );
+            int dead = ( int )( alive - ( cells + j ) );
+            if ( dead > 0 )
+                write_run( &w, dead, 'b' );
+            j += dead;
+            int start = j;
+            while ( j <= last && cells[j] )
+                j++;
+            write_run( &w, j - start, 'o' );
+        }
+    }
+    write_run( &w, 1, '!' );
+    fputc( '\n', fp );
+    if ( fclose( fp ) != 0 )
+    {
+        fprintf( stderr, File_IO_Err );
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+int write_life106_file( const char *file, Board *board )
+{
+    if ( file == NULL || board == NULL || board->grid == NULL )
+        return EXIT_FAILURE;
+    FILE *fp = fopen( file, "w" );
+    if ( fp == NULL )
+    {
+        fprintf( stderr, File_IO_Err );
+        return EXIT_FAILURE;
+    }
+    fprintf( fp, "%s\n", LIFE106_HEADER );
+    for ( int i = 0; i < board->rows; i++ )
+    {
+        const Cell *cells = board->grid[i], *alive = cells;
+        while ( ( alive = memchr( alive, 1, board->columns - ( alive - cells ) ) ) != NULL )
+        {
+            fprintf( fp, "%d %d\n", ( int )( alive - cells ), i );
+            alive++;
+        }
+    }
+    if ( fclose( fp ) != 0 )
+    {
+        fprintf( stderr, File_IO_Err );
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+int write_pattern_file( const char *file, Board *board )
+{
+    switch ( get_pattern_format( file ) )
+    {
+        case PATTERN_RLE:
+            return write_rle_file( file, board );
+        case PATTERN_LIFE106:
+            return write_life106_file( file, board );
+        default:
+            fprintf( stderr, "[Err] %s is not an RLE or Life 1.06 file\n", file != NULL ? file : "(null)" );
+            return EXIT_FAILURE;
+    }
+}
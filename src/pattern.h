@@ -0,0 +1,115 @@
+/**
+* @file: pattern.h
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file contains the function prototypes of the pattern files
+* Patterns in the RLE and Life 1.06 formats are read in blocks and fed through a parser
+* that keeps its state between blocks, so the cells are placed into the board as they
+* are read and the text is never held in memory. Patterns are written as RLE runs or
+* as the list of living cells, so a sparse board gives a small file.
+**/
+
+
+#ifndef PATTERN_H
+#define PATTERN_H
+
+
+/** Include all the libraries **/
+#include "board.h"
+
+
+/** Define all the marcos of the pattern files **/
+#define PATTERN_BLOCK_SIZE 65536    // The number of bytes read from a pattern file at once
+#define PATTERN_LINE_LENGTH 70      // The longest line of an RLE file written by this program
+#define RLE_EXTENSION ".rle"        // The extension of the RLE files
+#define LIFE106_EXTENSION ".lif"    // The extension of the Life 1.06 files
+#define LIFE106_HEADER "#Life 1.06" // The first line of a Life 1.06 file
+
+
+/** define all the enums and structs used by the pattern files **/
+typedef enum
+{
+    PATTERN_NONE,       // Not a pattern file
+    PATTERN_RLE,        // Runs of cells, "x = 3, y = 3" then "bo$2bo$3o!"
+    PATTERN_LIFE106     // "#Life 1.06" then one "x y" line per living cell
+} PatternFormat;
+
+typedef struct
+{
+    PatternFormat format;   // The format of the file
+    long width;             // The width given in the RLE header, 0 for Life 1.06
+    long height;            // The height given in the RLE header, 0 for Life 1.06
+    size_t cells;           // The number of living cells placed into the board
+    size_t clipped;         // The number of living cells that fell outside the board
+    uint32_t rule;          // The rule given in the RLE header, B3/S23 if there is none
+} PatternInfo;
+
+
+/** Declare all the function prototypes **/
+/* Get the format of a pattern file from its extension
+    *
+    * @param file: the name of the file
+    *
+    * @return: the format, PATTERN_NONE if the name is not a pattern file
+*/
+PatternFormat get_pattern_format( const char *file );
+
+/* Read a pattern file into a board, only its living cells are set and the others are left as they are
+    * The top left corner of an RLE pattern, or the cell (0, 0) of a Life 1.06 pattern,
+    * is placed at the given row and column. Living cells outside the board are dropped.
+    * The format is taken from the first line of the file, a file starting with
+    * LIFE106_HEADER is Life 1.06 and any other one is RLE.
+    *
+    * @param file: the name of the file
+    * @param board: the allocated board that receives the pattern
+    * @param row: the row of the origin of the pattern
+    * @param col: the column of the origin of the pattern
+    * @param info: receives the format, size and number of cells of the pattern, can be NULL
+    *
+    * @return: EXIT_SUCCESS if the pattern is read successfully, EXIT_FAILURE otherwise
+*/
+int read_pattern_file( const char *file, Board *board, int row, int col, PatternInfo *info );
+
+/* Write the living cells of a board as an RLE pattern, empty rows and the dead cells at
+    * the end of each row are left out, the header gives the rule of the board
+    *
+    * @param file: the name of the file
+    * @param board: the board to be saved
+    *
+    * @return: EXIT_SUCCESS if the file is saved successfully, EXIT_FAILURE otherwise
+*/
+int write_rle_file( const char *file, Board *board );
+
+/* Write the living cells of a board as a Life 1.06 pattern, one "column row" line each
+    *
+    * @param file: the name of the file
+    * @param board: the board to be saved
+    *
+    * @return: EXIT_SUCCESS if the file is saved successfully, EXIT_FAILURE otherwise
+*/
+int write_life106_file( const char *file, Board *board );
+
+/* Write a board in the pattern format given by the extension of the file
+    *
+    * @param file: the name of the file, it has to end with RLE_EXTENSION or LIFE106_EXTENSION
+    * @param board: the board to be saved
+    *
+    * @return: EXIT_SUCCESS if the file is saved successfully, EXIT_FAILURE otherwise
+*/
+int write_pattern_file( const char *file, Board *board );
+
+
+#endif
@@ -0,0 +1,138 @@
+/**
+* @file: pool.c
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file contains all the functions of the thread pool
+* All the according function prototypes are defined in pool.h
+**/
+
+/** Head files **/
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include "pool.h"
+
+
+/** The arguments of a worker thread **/
+typedef struct
+{
+    ThreadPool *pool;   // The pool the worker belongs to
+    int index;          // The number of the worker, from 1
+} Worker;
+
+
+/* The loop of a worker thread, it runs every posted task until the pool quits */
+static void *run_worker( void *arg )
+{
+    Worker worker = *( Worker* )arg;
+    ThreadPool *pool = worker.pool;
+    free( arg );
+    unsigned long seen = 0;
+    pthread_mutex_lock( &pool->lock );
+    for ( ;; )
+    {
+        while ( pool->round == seen && !pool->quit )
+            pthread_cond_wait( &pool->wake, &pool->lock );
+        if ( pool->quit )
+            break;
+        seen = pool->round;
+        PoolTask task = pool->task;
+        void *context = pool->context;
+        pthread_mutex_unlock( &pool->lock );
+        task( context, worker.index, pool->threads );
+        pthread_mutex_lock( &pool->lock );
+        // The last worker to finish releases the thread waiting in run_thread_pool
+        if ( --pool->running == 0 )
+            pthread_cond_signal( &pool->done );
+    }
+    pthread_mutex_unlock( &pool->lock );
+    return NULL;
+}
+
+int init_thread_pool( ThreadPool *pool, int threads )
+{
+    if ( pool == NULL || threads < 1 )
+        return EXIT_FAILURE;
+    pool->threads = threads;
+    pool->round = 0;
+    pool->running = 0;
+    pool->quit = 0;
+    pool->task = NULL;
+    pool->context = NULL;
+    pool->workers = ( pthread_t* )malloc( threads * sizeof( pthread_t ) );
+    if ( pool->workers == NULL )
+        return EXIT_FAILURE;
+    pthread_mutex_init( &pool->lock, NULL );
+    pthread_cond_init( &pool->wake, NULL );
+    pthread_cond_init( &pool->done, NULL );
+    for ( int i = 1; i < threads; i++ )
+    {
+        Worker *worker = ( Worker* )malloc( sizeof( Worker ) );
+        if ( worker != NULL )
+        {
+            worker->pool = pool;
+            worker->index = i;
+        }
+        if ( worker == NULL || pthread_create( &pool->workers[i - 1], NULL, run_worker, worker ) != 0 )
+        {
+            fprintf( stderr, "[Err] Unable to start worker thread %d\n", i );
+            free( worker );
+            pool->threads = i;
+            free_thread_pool( pool );
+            return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+void run_thread_pool( ThreadPool *pool, PoolTask task, void *context )
+{
+    if ( pool->threads == 1 )
+    {
+        task( context, 0, 1 );
+        return;
+    }
+    pthread_mutex_lock( &pool->lock );
+    pool->task = task;
+    pool->context = context;
+    pool->running = pool->threads - 1;
+    pool->round++;
+    pthread_cond_broadcast( &pool->wake );
+    pthread_mutex_unlock( &pool->lock );
+    // The calling thread does its own share while the workers run
+    task( context, 0, pool->threads );
+    pthread_mutex_lock( &pool->lock );
+    while ( pool->running > 0 )
+        pthread_cond_wait( &pool->done, &pool->lock );
+    pthread_mutex_unlock( &pool->lock );
+}
+
+void free_thread_pool( ThreadPool *pool )
+{
+    if ( pool == NULL || pool->workers == NULL )
+        return;
+    pthread_mutex_lock( &pool->lock );
+    pool->quit = 1;
+    pthread_cond_broadcast( &pool->wake );
+    pthread_mutex_unlock( &pool->lock );
+    for ( int i = 1; i < pool->threads; i++ )
+        pthread_join( pool->workers[i - 1], NULL );
+    pthread_mutex_destroy( &pool->lock );
+    pthread_cond_destroy( &pool->wake );
+    pthread_cond_destroy( &pool->done );
+    free( pool->workers );
+    pool->workers = NULL;
+}
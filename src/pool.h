@@ -0,0 +1,81 @@
+/**
+* @file: pool.h
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file contains the function prototypes of the thread pool
+* The worker threads are created once and then woken up for every task,
+* so no thread is created while the simulation is running
+**/
+
+
+#ifndef POOL_H
+#define POOL_H
+
+
+/** Include all the libraries **/
+#include <pthread.h>
+
+
+/** define all the structs used in the thread pool **/
+/* A task run by every thread of the pool, index is the number of the thread and count is the number of threads */
+typedef void ( *PoolTask )( void *context, int index, int count );
+
+typedef struct
+{
+    int threads;                // The number of threads, including the calling thread
+    pthread_t *workers;         // The worker threads, threads - 1 of them
+    pthread_mutex_t lock;       // The lock protecting everything below
+    pthread_cond_t wake;        // Signalled when a new task is posted
+    pthread_cond_t done;        // Signalled when the last worker finishes the task
+    PoolTask task;              // The task being run
+    void *context;              // The context passed to the task
+    unsigned long round;        // The number of tasks posted so far
+    int running;                // The number of workers still running the task
+    int quit;                   // Set when the workers should exit
+} ThreadPool;
+
+
+/** Declare all the function prototypes **/
+/* Initialize a thread pool and start its worker threads
+    *
+    * @param pool: the thread pool to be initialized
+    * @param threads: the number of threads, including the calling thread
+    *
+    * @return: EXIT_SUCCESS if the pool is initialized successfully, EXIT_FAILURE otherwise
+*/
+int init_thread_pool( ThreadPool *pool, int threads );
+
+/* Run a task on every thread of the pool and wait for all of them to finish
+    * The calling thread runs the task as thread 0
+    *
+    * @param pool: the thread pool
+    * @param task: the task to be run
+    * @param context: the context passed to the task
+    *
+    * @return: none
+*/
+void run_thread_pool( ThreadPool *pool, PoolTask task, void *context );
+
+/* Stop the worker threads and free the thread pool
+    *
+    * @param pool: the thread pool to be freed
+    *
+    * @return: none
+*/
+void free_thread_pool( ThreadPool *pool );
+
+
+#endif
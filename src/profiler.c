@@ -0,0 +1,136 @@
+/**
+* @file: profiler.c
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file contains all the functions of the frame profiler
+* All the according function prototypes are defined in profiler.h
+**/
+
+/** Head files **/
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "profiler.h"
+
+
+/** The names of the phases, in the order of FramePhase **/
+static const char *phase_names[FRAME_PHASE_COUNT] = { "events", "snapshot", "autosave", "board", "hud", "buttons", "present", "frame" };
+
+
+/* Get the time of a monotonic clock in nanoseconds */
+static int64_t now_ns( void )
+{
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return ( int64_t )ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/* Compare two times for qsort */
+static int compare_times( const void *a, const void *b )
+{
+    double x = *( const double* )a, y = *( const double* )b;
+    return ( x > y ) - ( x < y );
+}
+
+
+int init_frame_profiler( FrameProfiler *profiler, const char *csv_file )
+{
+    if ( profiler == NULL )
+        return EXIT_FAILURE;
+    memset( profiler, 0, sizeof( FrameProfiler ) );
+    if ( csv_file == NULL )
+        return EXIT_SUCCESS;
+    profiler->csv = fopen( csv_file, "w" );
+    if ( profiler->csv == NULL )
+    {
+        fprintf( stderr, "[Err] The frame log %s could not be created\n", csv_file );
+        return EXIT_FAILURE;
+    }
+    fprintf( profiler->csv, "frame" );
+    for ( int i = 0; i < FRAME_PHASE_COUNT; i++ )
+        fprintf( profiler->csv, ",%s_ms", phase_names[i] );
+    fprintf( profiler->csv, "\n" );
+    return EXIT_SUCCESS;
+}
+
+void free_frame_profiler( FrameProfiler *profiler )
+{
+    if ( profiler == NULL || profiler->csv == NULL )
+        return;
+    fclose( profiler->csv );
+    profiler->csv = NULL;
+}
+
+const char *get_frame_phase_name( FramePhase phase )
+{
+    if ( ( int )phase < 0 || phase >= FRAME_PHASE_COUNT )
+        return "unknown";
+    return phase_names[phase];
+}
+
+void begin_frame( FrameProfiler *profiler )
+{
+    memset( profiler->current, 0, sizeof( profiler->current ) );
+    profiler->frame_start = profiler->mark = now_ns();
+}
+
+void end_frame_phase( FrameProfiler *profiler, FramePhase phase )
+{
+    int64_t now = now_ns();
+    profiler->current[phase] += ( now - profiler->mark ) / 1e6;
+    profiler->mark = now;
+}
+
+void end_frame( FrameProfiler *profiler )
+{
+    profiler->current[FRAME_TOTAL] = ( profiler->mark - profiler->frame_start ) / 1e6;
+    add_frame_times( profiler, profiler->current );
+}
+
+void add_frame_times( FrameProfiler *profiler, const double *times )
+{
+    memcpy( profiler->times[profiler->frames % FRAME_HISTORY], times, sizeof( profiler->current ) );
+    // The lines are left to the buffer of the file, so a frame never waits for the disk
+    if ( profiler->csv != NULL )
+    {
+        fprintf( profiler->csv, "%llu", ( unsigned long long )profiler->frames );
+        for ( int i = 0; i < FRAME_PHASE_COUNT; i++ )
+            fprintf( profiler->csv, ",%.4f", times[i] );
+        fprintf( profiler->csv, "\n" );
+    }
+    profiler->frames++;
+}
+
+void get_frame_stats( FrameProfiler *profiler, FramePhase phase, FrameStats *stats )
+{
+    double sorted[FRAME_HISTORY];
+    int count = profiler->frames < FRAME_HISTORY ? ( int )profiler->frames : FRAME_HISTORY;
+    memset( stats, 0, sizeof( FrameStats ) );
+    if ( count == 0 )
+        return;
+    double sum = 0;
+    for ( int i = 0; i < count; i++ )
+    {
+        sorted[i] = profiler->times[i][phase];
+        sum += sorted[i];
+    }
+    qsort( sorted, count, sizeof( double ), compare_times );
+    stats->min = sorted[0];
+    stats->average = sum / count;
+    // The nearest rank, the smallest time that at least 99% of the frames are not slower than
+    stats->p99 = sorted[( 99 * count + 99 ) / 100 - 1];
+}
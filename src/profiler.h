@@ -0,0 +1,142 @@
+/**
+* @file: profiler.h
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file contains the function prototypes of the frame profiler
+* Each phase of a frame of the game is timed by reading a monotonic clock once at its end,
+* the time since the previous reading is charged to the phase. The times of the last
+* FRAME_HISTORY frames are kept for the rolling minimum, average and 99th percentile,
+* and every frame can be streamed to a CSV file to find stutters afterwards.
+**/
+
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+
+/** Include all the libraries **/
+#include <stdio.h>
+#include <stdint.h>
+
+
+/** Define all the marcos of the frame profiler **/
+#define FRAME_HISTORY 256       // The number of frames the rolling statistics are taken over
+
+
+/** define all the enums and structs used by the frame profiler **/
+typedef enum
+{
+    FRAME_EVENTS,       // Polling and handling the SDL events
+    FRAME_SNAPSHOT,     // Taking the latest generation from the simulation thread
+    FRAME_AUTOSAVE,     // Copying the board for the autosave thread
+    FRAME_BOARD,        // draw_board
+    FRAME_HUD,          // Drawing the status bar and the overlay
+    FRAME_BUTTONS,      // render_button
+    FRAME_PRESENT,      // SDL_RenderPresent, including the wait for the vertical sync
+    FRAME_TOTAL,        // The whole frame, from its start to the end of the last phase
+    FRAME_PHASE_COUNT   // The number of phases
+} FramePhase;
+
+typedef struct
+{
+    double min;             // The shortest time in milliseconds
+    double average;         // The average time in milliseconds
+    double p99;             // The time 99% of the frames were not slower than, in milliseconds
+} FrameStats;
+
+typedef struct
+{
+    double times[FRAME_HISTORY][FRAME_PHASE_COUNT];    // The times of the last frames in milliseconds, by frame % FRAME_HISTORY
+    double current[FRAME_PHASE_COUNT];  // The times of the frame being measured
+    int64_t frame_start;    // The clock when the frame being measured started
+    int64_t mark;           // The clock at the end of the last phase
+    uint64_t frames;        // The number of frames recorded
+    FILE *csv;              // The file every frame is written to, NULL if there is none
+} FrameProfiler;
+
+
+/** Declare all the function prototypes **/
+/* Initialize a frame profiler
+    *
+    * @param profiler: the profiler to be initialized
+    * @param csv_file: the CSV file every frame is written to, NULL to not write them
+    *
+    * @return: EXIT_SUCCESS if the profiler is initialized successfully, EXIT_FAILURE if the file can not be created
+*/
+int init_frame_profiler( FrameProfiler *profiler, const char *csv_file );
+
+/* Close the CSV file of a frame profiler
+    *
+    * @param profiler: the profiler to be freed
+    *
+    * @return: none
+*/
+void free_frame_profiler( FrameProfiler *profiler );
+
+/* Get the name of a phase
+    *
+    * @param phase: the phase
+    *
+    * @return: the name of the phase
+*/
+const char *get_frame_phase_name( FramePhase phase );
+
+/* Start timing a frame, the times of a frame that is never ended are dropped
+    *
+    * @param profiler: the profiler
+    *
+    * @return: none
+*/
+void begin_frame( FrameProfiler *profiler );
+
+/* End a phase of the frame, the time since the previous phase ended is added to it
+    *
+    * @param profiler: the profiler
+    * @param phase: the phase that ended
+    *
+    * @return: none
+*/
+void end_frame_phase( FrameProfiler *profiler, FramePhase phase );
+
+/* End the frame and record its times
+    *
+    * @param profiler: the profiler
+    *
+    * @return: none
+*/
+void end_frame( FrameProfiler *profiler );
+
+/* Record the times of a frame, end_frame records the measured ones with it
+    *
+    * @param profiler: the profiler
+    * @param times: the time of every phase in milliseconds, FRAME_PHASE_COUNT of them
+    *
+    * @return: none
+*/
+void add_frame_times( FrameProfiler *profiler, const double *times );
+
+/* Get the rolling statistics of a phase over the last FRAME_HISTORY frames
+    *
+    * @param profiler: the profiler
+    * @param phase: the phase
+    * @param stats: receives the statistics, all 0 before the first frame
+    *
+    * @return: none
+*/
+void get_frame_stats( FrameProfiler *profiler, FramePhase phase, FrameStats *stats );
+
+
+#endif
@@ -0,0 +1,122 @@
+/**
+* @file: rule.c
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file contains all the functions of the Life-like rules
+* All the according function prototypes are defined in rule.h
+**/
+
+/** Head files **/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "rule.h"
+
+
+/** The rules known by their names **/
+static const struct
+{
+    const char *name;
+    uint32_t rule;
+} rule_names[] = {
+    { "conway", RULE_CONWAY },
+    { "life", RULE_CONWAY },
+    { "highlife", RULE_HIGHLIFE },
+    { "daynight", RULE_DAY_AND_NIGHT },
+    { "seeds", RULE_SEEDS }
+};
+
+
+/* Read a list of neighbour counts into the bits of a rule, it returns the first character after the list */
+static const char *parse_counts( const char *text, uint32_t *rule, int shift )
+{
+    while ( *text >= '0' && *text <= '8' )
+    {
+        *rule |= ( uint32_t )1 << ( shift + *text - '0' );
+        text++;
+    }
+    return text;
+}
+
+
+int parse_rule( const char *text, uint32_t *rule )
+{
+    if ( text == NULL || rule == NULL )
+        return EXIT_FAILURE;
+    for ( size_t i = 0; i < sizeof( rule_names ) / sizeof( rule_names[0] ); i++ )
+    {
+        if ( strcmp( text, rule_names[i].name ) == 0 )
+        {
+            *rule = rule_names[i].rule;
+            return EXIT_SUCCESS;
+        }
+    }
+    uint32_t parsed = 0;
+    const char *p = text;
+    if ( toupper( ( unsigned char )*p ) == 'B' )
+    {
+        // B/S notation, the births come first
+        p = parse_counts( p + 1, &parsed, 0 );
+        if ( *p != '/' || toupper( ( unsigned char )p[1] ) != 'S' )
+            p = NULL;
+        else
+            p = parse_counts( p + 2, &parsed, 9 );
+    }
+    else if ( toupper( ( unsigned char )*p ) == 'S' )
+    {
+        // The same with the survivals first, "S23/B3"
+        p = parse_counts( p + 1, &parsed, 9 );
+        if ( *p != '/' || toupper( ( unsigned char )p[1] ) != 'B' )
+            p = NULL;
+        else
+            p = parse_counts( p + 2, &parsed, 0 );
+    }
+    else
+    {
+        // S/B notation, the survivals come first
+        p = parse_counts( p, &parsed, 9 );
+        p = *p == '/' ? parse_counts( p + 1, &parsed, 0 ) : NULL;
+    }
+    if ( p == NULL || *p != '\0' )
+    {
+        fprintf( stderr, "[Err] Invalid rule: %s, it has to look like B3/S23\n", text );
+        return EXIT_FAILURE;
+    }
+    if ( parsed & RULE_BIRTH( 0 ) )
+    {
+        fprintf( stderr, "[Err] Rules with B0 are not supported: %s\n", text );
+        return EXIT_FAILURE;
+    }
+    *rule = parsed;
+    return EXIT_SUCCESS;
+}
+
+char *format_rule( uint32_t rule, char *text )
+{
+    char *p = text;
+    *p++ = 'B';
+    for ( int n = 0; n <= 8; n++ )
+        if ( rule & RULE_BIRTH( n ) )
+            *p++ = ( char )( '0' + n );
+    *p++ = '/';
+    *p++ = 'S';
+    for ( int n = 0; n <= 8; n++ )
+        if ( rule & RULE_SURVIVE( n ) )
+            *p++ = ( char )( '0' + n );
+    *p = '\0';
+    return text;
+}
@@ -0,0 +1,81 @@
+/**
+* @file: rule.h
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file contains the function prototypes of the Life-like rules
+* A rule is written as "B3/S23": a dead cell is born with any of the neighbour counts
+* after B and a living cell survives with any of the counts after S. It is compiled into
+* one mask, bit n is set if a dead cell with n neighbours is born and bit 9 + n is set
+* if a living cell with n neighbours survives, so the next state is a single shift.
+**/
+
+
+#ifndef RULE_H
+#define RULE_H
+
+
+/** Include all the libraries **/
+#include <stdint.h>
+
+
+/** Define all the marcos of the rules **/
+#define RULE_BIRTH( n ) ( ( uint32_t )1 << ( n ) )            // The bit of a birth with n neighbours
+#define RULE_SURVIVE( n ) ( ( uint32_t )1 << ( 9 + ( n ) ) )  // The bit of a survival with n neighbours
+#define RULE_MASK ( ( ( uint32_t )1 << 18 ) - 1 )             // The bits used by a rule
+#define RULE_CONWAY ( RULE_BIRTH( 3 ) | RULE_SURVIVE( 2 ) | RULE_SURVIVE( 3 ) )      // B3/S23
+#define RULE_HIGHLIFE ( RULE_CONWAY | RULE_BIRTH( 6 ) )                              // B36/S23
+#define RULE_DAY_AND_NIGHT ( RULE_BIRTH( 3 ) | RULE_BIRTH( 6 ) | RULE_BIRTH( 7 ) | RULE_BIRTH( 8 ) | \
+    RULE_SURVIVE( 3 ) | RULE_SURVIVE( 4 ) | RULE_SURVIVE( 6 ) | RULE_SURVIVE( 7 ) | RULE_SURVIVE( 8 ) )  // B3678/S34678
+#define RULE_SEEDS RULE_BIRTH( 2 )                                                   // B2/S
+#define RULE_TEXT_LENGTH 24     // The longest rule written by format_rule, "B12345678/S012345678" and the end
+
+
+/** Declare all the function prototypes **/
+/* Get the next state of a cell
+    *
+    * @param rule: the rule
+    * @param alive: the current state of the cell
+    * @param count: the number of living neighbours, from 0 to 8
+    *
+    * @return: 1 if the cell is alive in the next generation, 0 otherwise
+*/
+static inline int get_next_state( uint32_t rule, int alive, int count )
+{
+    return ( int )( ( rule >> ( count + ( alive ? 9 : 0 ) ) ) & 1 );
+}
+
+/* Parse a rule from the B/S notation ("B36/S23"), the S/B notation ("23/36") or a name
+    * "S23/B36" is read as well. The names are conway, highlife, daynight and seeds. Rules where a cell is born with
+    * no neighbours (B0) are refused, every empty region of the board would come alive.
+    *
+    * @param text: the text of the rule
+    * @param rule: receives the rule
+    *
+    * @return: EXIT_SUCCESS if the rule is parsed successfully, EXIT_FAILURE otherwise
+*/
+int parse_rule( const char *text, uint32_t *rule );
+
+/* Write a rule in the B/S notation
+    *
+    * @param rule: the rule
+    * @param text: receives the text, at least RULE_TEXT_LENGTH characters
+    *
+    * @return: the text
+*/
+char *format_rule( uint32_t rule, char *text );
+
+
+#endif
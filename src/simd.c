@@ -0,0 +1,280 @@
+/**
+* @file: simd.c
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file contains all the functions of the vectorized board backend
+* All the according function prototypes are defined in simd.h
+**/
+
+/** Head files **/
+#include <stdint.h>
+#include "simd.h"
+
+/** The vector kernels are only built for x86 compilers that support per function targets **/
+#if defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+#define SIMD_X86
+#include <immintrin.h>
+#endif
+
+
+/** A kernel writes the next generation of a band of rows into the back buffer **/
+typedef void ( *StepRows )( SimdBoard *sb, int first_row, int last_row );
+
+static const char *kernel_names[SIMD_KERNEL_COUNT] = { "scalar", "sse2", "avx2" };
+static int kernel_selected = 0;
+static SimdKernel kernel = SIMD_SCALAR;
+
+
+/* The number of bytes of each row that the vector kernels write */
+static size_t padded_width( int columns )
+{
+    return ( ( size_t )columns + SIMD_WIDTH - 1 ) / SIMD_WIDTH * SIMD_WIDTH;
+}
+
+/* The portable kernel, one cell at a time */
+static void step_rows_scalar( SimdBoard *sb, int first_row, int last_row )
+{
+    for ( int i = first_row; i < last_row; i++ )
+    {
+        // The rows above the first row and below the last row are zero, so are the bytes around each row
+        const Cell *m = sb->cells + ( size_t )i * sb->stride;
+        const Cell *a = m - sb->stride, *b = m + sb->stride;
+        Cell *out = sb->next + ( size_t )i * sb->stride;
+        for ( int x = 0; x < sb->columns; x++ )
+        {
+            int sum = a[x - 1] + a[x] + a[x + 1] + m[x - 1] + m[x + 1] + b[x - 1] + b[x] + b[x + 1];
+            out[x] = ( Cell )get_next_state( sb->rule, m[x], sum );
+        }
+    }
+}
+
+#ifdef SIMD_X86
+/* The SSE2 kernel, 16 cells per instruction */
+__attribute__(( target( "sse2" ) ))
+static void step_rows_sse2( SimdBoard *sb, int first_row, int last_row )
+{
+    const size_t width = padded_width( sb->columns );
+    const __m128i one = _mm_set1_epi8( 1 ), two = _mm_set1_epi8( 2 ), three = _mm_set1_epi8( 3 );
+    const int conway = sb->rule == RULE_CONWAY;
+    char birth[9], survival[9];
+    int births = 0, survivals = 0;
+    for ( int n = 0; n <= 8; n++ )
+    {
+        if ( sb->rule & RULE_BIRTH( n ) )
+            birth[births++] = ( char )n;
+        if ( sb->rule & RULE_SURVIVE( n ) )
+            survival[survivals++] = ( char )n;
+    }
+    for ( int i = first_row; i < last_row; i++ )
+    {
+        const Cell *m = sb->cells + ( size_t )i * sb->stride;
+        const Cell *a = m - sb->stride, *b = m + sb->stride;
+        Cell *out = sb->next + ( size_t )i * sb->stride;
+        for ( size_t x = 0; x < width; x += 16 )
+        {
+            __m128i sum = _mm_add_epi8( _mm_loadu_si128( ( const __m128i* )( a + x - 1 ) ), _mm_load_si128( ( const __m128i* )( a + x ) ) );
+            sum = _mm_add_epi8( sum, _mm_loadu_si128( ( const __m128i* )( a + x + 1 ) ) );
+            sum = _mm_add_epi8( sum, _mm_loadu_si128( ( const __m128i* )( m + x - 1 ) ) );
+            sum = _mm_add_epi8( sum, _mm_loadu_si128( ( const __m128i* )( m + x + 1 ) ) );
+            sum = _mm_add_epi8( sum, _mm_loadu_si128( ( const __m128i* )( b + x - 1 ) ) );
+            sum = _mm_add_epi8( sum, _mm_load_si128( ( const __m128i* )( b + x ) ) );
+            sum = _mm_add_epi8( sum, _mm_loadu_si128( ( const __m128i* )( b + x + 1 ) ) );
+            __m128i cell = _mm_load_si128( ( const __m128i* )( m + x ) );
+            __m128i born, stay;
+            if ( conway )
+            {
+                born = _mm_and_si128( _mm_cmpeq_epi8( sum, three ), one );
+                stay = _mm_and_si128( _mm_cmpeq_epi8( sum, two ), cell );
+            }
+            else
+            {
+                // SSE2 has no byte shuffle, so every count of the rule is compared
+                born = stay = _mm_setzero_si128();
+                for ( int n = 0; n < births; n++ )
+                    born = _mm_or_si128( born, _mm_cmpeq_epi8( sum, _mm_set1_epi8( birth[n] ) ) );
+                for ( int n = 0; n < survivals; n++ )
+                    stay = _mm_or_si128( stay, _mm_cmpeq_epi8( sum, _mm_set1_epi8( survival[n] ) ) );
+                born = _mm_andnot_si128( cell, _mm_and_si128( born, one ) );
+                stay = _mm_and_si128( stay, cell );
+            }
+            _mm_store_si128( ( __m128i* )( out + x ), _mm_or_si128( born, stay ) );
+        }
+        // The padding after the last column has to stay dead
+        memset( out + sb->columns, 0, width - sb->columns );
+    }
+}
+
+/* The AVX2 kernel, 32 cells per instruction */
+__attribute__(( target( "avx2" ) ))
+static void step_rows_avx2( SimdBoard *sb, int first_row, int last_row )
+{
+    const size_t width = padded_width( sb->columns );
+    // The next state of each count is looked up with a byte shuffle, so every rule costs the same
+    char birth[16] = { 0 }, survival[16] = { 0 };
+    for ( int n = 0; n <= 8; n++ )
+    {
+        birth[n] = ( char )( ( sb->rule & RULE_BIRTH( n ) ) != 0 );
+        survival[n] = ( char )( ( sb->rule & RULE_SURVIVE( n ) ) != 0 );
+    }
+    const __m256i born_table = _mm256_broadcastsi128_si256( _mm_loadu_si128( ( const __m128i* )birth ) );
+    const __m256i stay_table = _mm256_broadcastsi128_si256( _mm_loadu_si128( ( const __m128i* )survival ) );
+    for ( int i = first_row; i < last_row; i++ )
+    {
+        const Cell *m = sb->cells + ( size_t )i * sb->stride;
+        const Cell *a = m - sb->stride, *b = m + sb->stride;
+        Cell *out = sb->next + ( size_t )i * sb->stride;
+        for ( size_t x = 0; x < width; x += 32 )
+        {
+            __m256i sum = _mm256_add_epi8( _mm256_loadu_si256( ( const __m256i* )( a + x - 1 ) ), _mm256_load_si256( ( const __m256i* )( a + x ) ) );
+            sum = _mm256_add_epi8( sum, _mm256_loadu_si256( ( const __m256i* )( a + x + 1 ) ) );
+            sum = _mm256_add_epi8( sum, _mm256_loadu_si256( ( const __m256i* )( m + x - 1 ) ) );
+            sum = _mm256_add_epi8( sum, _mm256_loadu_si256( ( const __m256i* )( m + x + 1 ) ) );
+            sum = _mm256_add_epi8( sum, _mm256_loadu_si256( ( const __m256i* )( b + x - 1 ) ) );
+            sum = _mm256_add_epi8( sum, _mm256_load_si256( ( const __m256i* )( b + x ) ) );
+            sum = _mm256_add_epi8( sum, _mm256_loadu_si256( ( const __m256i* )( b + x + 1 ) ) );
+            __m256i cell = _mm256_load_si256( ( const __m256i* )( m + x ) );
+            __m256i born = _mm256_andnot_si256( cell, _mm256_shuffle_epi8( born_table, sum ) );
+            __m256i stay = _mm256_and_si256( _mm256_shuffle_epi8( stay_table, sum ), cell );
+            _mm256_store_si256( ( __m256i* )( out + x ), _mm256_or_si256( born, stay ) );
+        }
+        memset( out + sb->columns, 0, width - sb->columns );
+    }
+}
+#endif
+
+/* Get the function of a kernel */
+static StepRows get_step_rows( SimdKernel k )
+{
+#ifdef SIMD_X86
+    if ( k == SIMD_AVX2 )
+        return step_rows_avx2;
+    if ( k == SIMD_SSE2 )
+        return step_rows_sse2;
+#endif
+    return step_rows_scalar;
+}
+
+SimdKernel detect_simd_kernel( void )
+{
+#ifdef SIMD_X86
+    // CPUID is read once by the compiler runtime
+    __builtin_cpu_init();
+    if ( __builtin_cpu_supports( "avx2" ) )
+        return SIMD_AVX2;
+    if ( __builtin_cpu_supports( "sse2" ) )
+        return SIMD_SSE2;
+#endif
+    return SIMD_SCALAR;
+}
+
+SimdKernel get_simd_kernel( void )
+{
+    if ( !kernel_selected )
+    {
+        kernel = detect_simd_kernel();
+        kernel_selected = 1;
+    }
+    return kernel;
+}
+
+int select_simd_kernel( SimdKernel k )
+{
+    if ( ( int )k < 0 || k >= SIMD_KERNEL_COUNT || k > detect_simd_kernel() )
+        return EXIT_FAILURE;
+    kernel = k;
+    kernel_selected = 1;
+    return EXIT_SUCCESS;
+}
+
+const char *get_simd_kernel_name( SimdKernel k )
+{
+    if ( ( int )k < 0 || k >= SIMD_KERNEL_COUNT )
+        return "unknown";
+    return kernel_names[k];
+}
+
+int init_simd_board( SimdBoard *sb, int rows, int columns )
+{
+    if ( sb == NULL || rows <= 0 || columns <= 0 )
+        return EXIT_FAILURE;
+    sb->rows = rows;
+    sb->columns = columns;
+    sb->rule = RULE_CONWAY;
+    sb->boundary = BOUNDARY_DEAD;
+    // Every row starts with SIMD_WIDTH zero bytes, which are also the padding after the previous row
+    sb->stride = padded_width( columns ) + SIMD_WIDTH;
+    // A zero row above and two below each buffer keep every shifted load inside the allocation
+    size_t buffer = ( ( size_t )rows + 3 ) * sb->stride;
+    sb->memory = ( Cell* )calloc( 2 * buffer + SIMD_WIDTH, sizeof( Cell ) );
+    if ( sb->memory == NULL )
+    {
+        fprintf( stderr, "[Err] Unable to allocate a %d x %d vectorized board\n", rows, columns );
+        return EXIT_FAILURE;
+    }
+    Cell *aligned = sb->memory + ( SIMD_WIDTH - ( uintptr_t )sb->memory % SIMD_WIDTH ) % SIMD_WIDTH;
+    sb->cells = aligned + sb->stride + SIMD_WIDTH;
+    sb->next = sb->cells + buffer;
+    return EXIT_SUCCESS;
+}
+
+void free_simd_board( SimdBoard *sb )
+{
+    if ( sb == NULL )
+        return;
+    free( sb->memory );
+    sb->memory = sb->cells = sb->next = NULL;
+}
+
+int load_simd_board_from_board( SimdBoard *sb, Board *board )
+{
+    if ( sb == NULL || board == NULL )
+        return EXIT_FAILURE;
+    if ( init_simd_board( sb, board->rows, board->columns ) == EXIT_FAILURE )
+        return EXIT_FAILURE;
+    sb->rule = board->rule;
+    sb->boundary = board->boundary;
+    for ( int i = 0; i < board->rows; i++ )
+    {
+        Cell *row = sb->cells + ( size_t )i * sb->stride;
+        for ( int j = 0; j < board->columns; j++ )
+            row[j] = board->grid[i][j] ? 1 : 0;
+    }
+    return EXIT_SUCCESS;
+}
+
+int store_simd_board_to_board( SimdBoard *sb, Board *board )
+{
+    if ( sb == NULL || board == NULL || sb->rows != board->rows || sb->columns != board->columns )
+        return EXIT_FAILURE;
+    for ( int i = 0; i < board->rows; i++ )
+        memcpy( board->grid[i], sb->cells + ( size_t )i * sb->stride, board->columns );
+    return EXIT_SUCCESS;
+}
+
+int update_next_generation_simd( SimdBoard *sb )
+{
+    if ( sb == NULL || sb->cells == NULL )
+        return EXIT_FAILURE;
+    // The bytes around the rows stay zero for dead edges, the other boundaries copy the opposite edges there
+    if ( sb->boundary != BOUNDARY_DEAD )
+        fill_halo( sb->cells, sb->stride, sb->rows, sb->columns, sb->boundary );
+    get_step_rows( get_simd_kernel() )( sb, 0, sb->rows );
+    // The next generation becomes the current one
+    Cell *swap = sb->cells;
+    sb->cells = sb->next;
+    sb->next = swap;
+    return EXIT_SUCCESS;
+}
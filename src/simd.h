@@ -0,0 +1,133 @@
+/**
+* @file: simd.h
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file contains the function prototypes of the vectorized board backend
+* Every cell is one byte and the neighbours of 32 (AVX2) or 16 (SSE2) cells are summed
+* at once by adding shifted rows, the kernel is picked at startup from the CPU features
+**/
+
+
+#ifndef SIMD_H
+#define SIMD_H
+
+
+/** Include all the libraries **/
+#include "board.h"
+
+
+/** Define all the marcos of the vectorized board **/
+#define SIMD_WIDTH 32           // The widest vector in bytes, every row is padded to a multiple of it
+
+
+/** define all the enums and structs used in the vectorized board **/
+typedef enum
+{
+    SIMD_SCALAR,        // Plain C, runs everywhere
+    SIMD_SSE2,          // 16 cells per instruction
+    SIMD_AVX2,          // 32 cells per instruction
+    SIMD_KERNEL_COUNT   // The number of kernels
+} SimdKernel;
+
+typedef struct
+{
+    int rows;           // The number of rows in the board
+    int columns;        // The number of columns in the board
+    size_t stride;      // The number of bytes between two rows, including the zero padding
+    uint32_t rule;      // The rule of the board, B3/S23 unless it is loaded from a board with another one
+    BoundaryMode boundary;  // The boundary of the board, the zero bytes around the rows are its halo
+    Cell *cells;        // The first cell of the current generation
+    Cell *next;         // The first cell of the buffer the next generation is written into
+    Cell *memory;       // The allocation that holds both buffers
+} SimdBoard;
+
+
+/** Declare all the function prototypes **/
+/* Initialize an empty vectorized board
+    *
+    * @param sb: the vectorized board to be initialized
+    * @param rows: the number of rows in the board
+    * @param columns: the number of columns in the board
+    *
+    * @return: EXIT_SUCCESS if the board is initialized successfully, EXIT_FAILURE otherwise
+*/
+int init_simd_board( SimdBoard *sb, int rows, int columns );
+
+/* Free the memory held by a vectorized board
+    *
+    * @param sb: the vectorized board to be freed
+    *
+    * @return: none
+*/
+void free_simd_board( SimdBoard *sb );
+
+/* Initialize a vectorized board with the cells of a board
+    *
+    * @param sb: the vectorized board to be initialized
+    * @param board: the board to be copied
+    *
+    * @return: EXIT_SUCCESS if the board is copied successfully, EXIT_FAILURE otherwise
+*/
+int load_simd_board_from_board( SimdBoard *sb, Board *board );
+
+/* Copy the cells of a vectorized board back to a board of the same size
+    *
+    * @param sb: the vectorized board
+    * @param board: the board that receives the cells
+    *
+    * @return: EXIT_SUCCESS if the board is copied successfully, EXIT_FAILURE otherwise
+*/
+int store_simd_board_to_board( SimdBoard *sb, Board *board );
+
+/* Update the vectorized board to the next generation with the selected kernel
+    * The rules and the boundaries are the same as update_next_generation
+    *
+    * @param sb: the vectorized board to be updated
+    *
+    * @return: EXIT_SUCCESS if the board is updated successfully
+*/
+int update_next_generation_simd( SimdBoard *sb );
+
+/* Find the fastest kernel that the CPU supports
+    *
+    * @return: the fastest supported kernel
+*/
+SimdKernel detect_simd_kernel( void );
+
+/* Get the kernel in use, the first call selects the fastest supported one
+    *
+    * @return: the kernel in use
+*/
+SimdKernel get_simd_kernel( void );
+
+/* Select the kernel used by update_next_generation_simd
+    *
+    * @param kernel: the kernel to be used
+    *
+    * @return: EXIT_SUCCESS if the CPU supports the kernel, EXIT_FAILURE otherwise
+*/
+int select_simd_kernel( SimdKernel kernel );
+
+/* Get the name of a kernel
+    *
+    * @param kernel: the kernel
+    *
+    * @return: the name of the kernel
+*/
+const char *get_simd_kernel_name( SimdKernel kernel );
+
+
+#endif
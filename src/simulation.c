@@ -0,0 +1,427 @@
+/**
+* @file: simulation.c
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file contains all the functions of the simulation thread
+* All the according function prototypes are defined in simulation.h
+**/
+
+/** Head files **/
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include "simulation.h"
+
+
+/** The longest the simulation thread sleeps before it looks at the command queue again **/
+#define SIM_IDLE_NS 1000000L
+
+
+/* Get the time of a monotonic clock in nanoseconds */
+static int64_t now_ns( void )
+{
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return ( int64_t )ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/* Sleep for a number of nanoseconds, at most SIM_IDLE_NS so commands are not left waiting */
+static void idle( int64_t ns )
+{
+    if ( ns > SIM_IDLE_NS )
+        ns = SIM_IDLE_NS;
+    struct timespec ts = { 0, ns };
+    nanosleep( &ts, NULL );
+}
+
+/* Copy the cells of the tiles in a change set between a board and the cells of a snapshot */
+static void copy_tiles( ChangeSet *cs, Board *board, Cell *cells, int to_board )
+{
+    int tiles = cs->all ? cs->tile_rows * cs->tile_columns : cs->count;
+    for ( int t = 0; t < tiles; t++ )
+    {
+        int tile = cs->all ? t : cs->tiles[t];
+        int first_row = tile / cs->tile_columns * CHANGE_TILE_SIZE;
+        int col = tile % cs->tile_columns * CHANGE_TILE_SIZE;
+        int last_row = first_row + CHANGE_TILE_SIZE < board->rows ? first_row + CHANGE_TILE_SIZE : board->rows;
+        int length = board->columns - col < CHANGE_TILE_SIZE ? board->columns - col : CHANGE_TILE_SIZE;
+        for ( int i = first_row; i < last_row; i++ )
+        {
+            Cell *row = cells + ( size_t )i * board->columns + col;
+            if ( to_board )
+                memcpy( board->grid[i] + col, row, length );
+            else
+                memcpy( row, board->grid[i] + col, length );
+        }
+    }
+}
+
+/* Copy the changed tiles of the board into the back snapshot and swap it with the middle one */
+static void publish_snapshot( Simulation *sim )
+{
+    Snapshot *snapshot = &sim->snapshots[sim->back];
+    // Every snapshot falls behind the board by the tiles that changed since it was written
+    for ( int i = 0; i < 3; i++ )
+        merge_change_set( &sim->stale[i], &sim->changes );
+    copy_tiles( &sim->stale[sim->back], &sim->board, snapshot->cells, 0 );
+    clear_change_set( &sim->stale[sim->back] );
+    // The UI needs the tiles changed since the last snapshot it took, the one before this one unless it was taken already
+    if ( !( __atomic_load_n( &sim->middle, __ATOMIC_ACQUIRE ) & SNAPSHOT_FRESH ) )
+        clear_change_set( &sim->unseen );
+    merge_change_set( &sim->unseen, &sim->changes );
+    clear_change_set( &sim->changes );
+    clear_change_set( &snapshot->changes );
+    merge_change_set( &snapshot->changes, &sim->unseen );
+    snapshot->generation = sim->generation;
+    snapshot->applied = sim->tail;
+    snapshot->paused = sim->paused;
+    snapshot->rate = sim->achieved_rate;
+    // The release half publishes the cells, the acquire half takes the snapshot the UI is done with
+    sim->back = __atomic_exchange_n( &sim->middle, sim->back | SNAPSHOT_FRESH, __ATOMIC_ACQ_REL ) & ~SNAPSHOT_FRESH;
+}
+
+/* Apply every queued command, the edits are written into the engine as it is
+    *
+    * @return: 1 if any command was applied, with *reload set when the engine has to be loaded from the board again
+*/
+static int apply_commands( Simulation *sim, int *reload )
+{
+    unsigned long head = __atomic_load_n( &sim->head, __ATOMIC_ACQUIRE );
+    unsigned long tail = sim->tail;
+    if ( tail == head )
+        return 0;
+    for ( ; tail != head; tail++ )
+    {
+        SimCommand *command = &sim->queue[tail & ( SIM_QUEUE_SIZE - 1 )];
+        switch ( command->type )
+        {
+            case SIM_SET_CELL:
+                if ( command->row >= 0 && command->row < sim->board.rows &&
+                    command->col >= 0 && command->col < sim->board.columns )
+                {
+                    sim->board.grid[command->row][command->col] = command->value != 0;
+                    mark_cell_changed( &sim->changes, command->row, command->col );
+                    if ( set_engine_cell( &sim->engine, command->row, command->col, command->value != 0 ) == EXIT_FAILURE )
+                        *reload = 1;
+                }
+                break;
+            case SIM_CLEAR:
+                clear_all_cells( &sim->board );
+                mark_all_changed( &sim->changes );
+                sim->generation = 0;
+                sim->paused = 1;
+                sim->achieved_rate = 0;
+                *reload = 1;
+                break;
+            case SIM_PAUSE:
+                sim->paused = 1;
+                sim->achieved_rate = 0;
+                break;
+            case SIM_RESUME:
+                sim->paused = 0;
+                break;
+            case SIM_SET_DELAY:
+                sim->delay = command->value;
+                break;
+            case SIM_SET_LIMIT:
+                sim->limit = command->value;
+                break;
+            case SIM_SET_RATE:
+                sim->rate = command->value;
+                break;
+        }
+    }
+    __atomic_store_n( &sim->tail, tail, __ATOMIC_RELEASE );
+    return 1;
+}
+
+/* Write the engine back to the board and add the tiles that differ from the last generation to the changes
+    * The engine is written into the back grid of the board, which is then compared with the front one and swapped with it
+*/
+static int store_generation( Simulation *sim )
+{
+    Board *board = &sim->board;
+    // The reference engine steps the board itself and lists its changes as it goes
+    if ( sim->type == ENGINE_REFERENCE )
+        return EXIT_SUCCESS;
+    Cell **previous = board->grid;
+    board->grid = board->next_grid;
+    board->next_grid = previous;
+    if ( store_engine_to_board( &sim->engine ) == EXIT_FAILURE )
+        return EXIT_FAILURE;
+    for ( int i = 0; i < board->rows; i++ )
+    {
+        for ( int j = 0; j < board->columns; j += CHANGE_TILE_SIZE )
+        {
+            int length = board->columns - j < CHANGE_TILE_SIZE ? board->columns - j : CHANGE_TILE_SIZE;
+            int tile = i / CHANGE_TILE_SIZE * sim->changes.tile_columns + j / CHANGE_TILE_SIZE;
+            if ( !sim->changes.dirty[tile] && memcmp( board->grid[i] + j, previous[i] + j, length ) != 0 )
+                mark_cell_changed( &sim->changes, i, j );
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+/* Run up to a number of generations, stopping early at the deadline or the limit
+    * The board is only written once, after the last generation of the batch
+    *
+    * @return: the number of generations run, -1 if the engine failed
+*/
+static long run_batch( Simulation *sim, long generations, int64_t deadline )
+{
+    long done = 0;
+    while ( done < generations )
+    {
+        int code = sim->type == ENGINE_REFERENCE ? update_next_generation_tracked( &sim->board, &sim->changes ) :
+            step_engine( &sim->engine, 1 );
+        if ( code == EXIT_FAILURE )
+            return -1;
+        done++;
+        sim->generation++;
+        if ( sim->generation == sim->limit )
+        {
+            sim->paused = 1;
+            break;
+        }
+        if ( now_ns() >= deadline )
+            break;
+    }
+    if ( store_generation( sim ) == EXIT_FAILURE )
+        return -1;
+    return done;
+}
+
+/* Measure the generations per second over windows of SIM_RATE_WINDOW_NS */
+static void measure_rate( Simulation *sim )
+{
+    int64_t now = now_ns();
+    if ( sim->window_start == 0 )
+    {
+        sim->window_start = now;
+        sim->window_generation = sim->generation;
+        return;
+    }
+    if ( now - sim->window_start < SIM_RATE_WINDOW_NS )
+        return;
+    sim->achieved_rate = ( sim->generation - sim->window_generation ) * 1e9 / ( now - sim->window_start );
+    sim->window_start = now;
+    sim->window_generation = sim->generation;
+}
+
+/* The loop of the simulation thread, it runs generations until the simulation is stopped */
+static void *run_simulation( void *arg )
+{
+    Simulation *sim = arg;
+    int64_t last_step = 0;
+    while ( !__atomic_load_n( &sim->quit, __ATOMIC_ACQUIRE ) )
+    {
+        int reload = 0;
+        if ( apply_commands( sim, &reload ) )
+        {
+            // Only a cleared board, or an engine without a fixed layout, is loaded from the board again
+            if ( reload )
+            {
+                free_engine( &sim->engine );
+                if ( init_engine( &sim->engine, sim->type, 1, &sim->board ) == EXIT_FAILURE )
+                {
+                    fprintf( stderr, "[Err] The simulation engine could not be loaded again\n" );
+                    sim->paused = 1;
+                    sim->type = ENGINE_REFERENCE;
+                    init_engine( &sim->engine, ENGINE_REFERENCE, 1, &sim->board );
+                }
+            }
+            publish_snapshot( sim );
+        }
+        if ( sim->paused )
+        {
+            sim->window_start = 0;
+            idle( SIM_IDLE_NS );
+            continue;
+        }
+        measure_rate( sim );
+        // Generations are paced by the clock of this thread, not by the frames of the UI
+        int64_t now = now_ns();
+        long due = 1;
+        if ( sim->rate == 0 )
+        {
+            int64_t wait = last_step + ( int64_t )sim->delay * 1000000 - now;
+            if ( wait > 0 )
+            {
+                idle( wait );
+                continue;
+            }
+            last_step = now;
+        }
+        else if ( sim->rate > 0 )
+        {
+            // A rate the engine cannot keep up with is not caught up later
+            int64_t interval = 1000000000 / sim->rate > 0 ? 1000000000 / sim->rate : 1;
+            if ( now - last_step > SIM_FRAME_NS + interval )
+                last_step = now - interval;
+            due = ( long )( ( now - last_step ) / interval );
+            if ( due == 0 )
+            {
+                idle( last_step + interval - now );
+                continue;
+            }
+            last_step += due * interval;
+        }
+        else
+            due = LONG_MAX;
+        // Every generation of a batch but the last one is never published
+        if ( run_batch( sim, due, now + SIM_FRAME_NS ) < 0 )
+        {
+            fprintf( stderr, "[Err] The simulation engine failed, the simulation is paused\n" );
+            sim->paused = 1;
+        }
+        publish_snapshot( sim );
+    }
+    return NULL;
+}
+
+
+/* Free the buffers of a simulation, the ones that were never allocated are skipped */
+static void free_simulation_memory( Simulation *sim )
+{
+    for ( int i = 0; i < 3; i++ )
+    {
+        free( sim->snapshots[i].cells );
+        free_change_set( &sim->snapshots[i].changes );
+        free_change_set( &sim->stale[i] );
+    }
+    free_change_set( &sim->changes );
+    free_change_set( &sim->unseen );
+    free_change_set( &sim->pending );
+    free_board( &sim->board );
+}
+
+
+int start_simulation( Simulation *sim, Board *board, EngineType type )
+{
+    memset( sim, 0, sizeof( Simulation ) );
+    sim->board.rows = board->rows;
+    sim->board.columns = board->columns;
+    sim->board.delay = board->delay;
+    sim->board.rule = board->rule;
+    sim->board.boundary = board->boundary;
+    if ( alloc_board( &sim->board ) == EXIT_FAILURE )
+        return EXIT_FAILURE;
+    for ( int i = 0; i < board->rows; i++ )
+        memcpy( sim->board.grid[i], board->grid[i], board->columns );
+    size_t size = ( size_t )board->rows * board->columns;
+    int code = EXIT_SUCCESS;
+    for ( int i = 0; i < 3 && code == EXIT_SUCCESS; i++ )
+    {
+        sim->snapshots[i].cells = malloc( size > 0 ? size : 1 );
+        if ( sim->snapshots[i].cells == NULL )
+        {
+            fprintf( stderr, "[Err] Memory allocation failed\n" );
+            code = EXIT_FAILURE;
+        }
+        else if ( init_change_set( &sim->snapshots[i].changes, board->rows, board->columns ) == EXIT_FAILURE ||
+            init_change_set( &sim->stale[i], board->rows, board->columns ) == EXIT_FAILURE )
+            code = EXIT_FAILURE;
+    }
+    if ( code == EXIT_FAILURE || init_change_set( &sim->changes, board->rows, board->columns ) == EXIT_FAILURE ||
+        init_change_set( &sim->unseen, board->rows, board->columns ) == EXIT_FAILURE ||
+        init_change_set( &sim->pending, board->rows, board->columns ) == EXIT_FAILURE )
+    {
+        free_simulation_memory( sim );
+        return EXIT_FAILURE;
+    }
+    // The UI may show another board before the first snapshot, so all of it is copied
+    mark_all_changed( &sim->changes );
+    sim->back = 0;
+    sim->middle = 1;
+    sim->front = 2;
+    sim->paused = 1;
+    sim->delay = board->delay;
+    sim->type = type;
+    if ( init_engine( &sim->engine, type, 1, &sim->board ) == EXIT_FAILURE )
+    {
+        free_simulation_memory( sim );
+        return EXIT_FAILURE;
+    }
+    publish_snapshot( sim );
+    if ( pthread_create( &sim->thread, NULL, run_simulation, sim ) != 0 )
+    {
+        fprintf( stderr, "[Err] The simulation thread could not be created\n" );
+        free_engine( &sim->engine );
+        free_simulation_memory( sim );
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+
+int send_simulation_command( Simulation *sim, SimCommandType type, int row, int col, long value )
+{
+    unsigned long head = sim->head;
+    if ( head - __atomic_load_n( &sim->tail, __ATOMIC_ACQUIRE ) >= SIM_QUEUE_SIZE )
+        return EXIT_FAILURE;
+    SimCommand *command = &sim->queue[head & ( SIM_QUEUE_SIZE - 1 )];
+    command->type = type;
+    command->row = row;
+    command->col = col;
+    command->value = value;
+    __atomic_store_n( &sim->head, head + 1, __ATOMIC_RELEASE );
+    return EXIT_SUCCESS;
+}
+
+
+int receive_snapshot( Simulation *sim, Board *board, ChangeSet *changes, Snapshot *snapshot )
+{
+    if ( !( __atomic_load_n( &sim->middle, __ATOMIC_ACQUIRE ) & SNAPSHOT_FRESH ) )
+        return 0;
+    sim->front = __atomic_exchange_n( &sim->middle, sim->front, __ATOMIC_ACQ_REL ) & ~SNAPSHOT_FRESH;
+    Snapshot *latest = &sim->snapshots[sim->front];
+    // The tiles of a skipped snapshot are copied from a later one, which has them as well
+    merge_change_set( &sim->pending, &latest->changes );
+    // A snapshot taken before the last command was applied would undo the edits already on the board
+    if ( latest->applied != sim->head )
+        return 0;
+    // Only the tiles listed by the simulation thread are copied and marked, so the board is drawn as before
+    copy_tiles( &sim->pending, board, latest->cells, 1 );
+    if ( changes != NULL && sim->pending.all )
+        mark_all_changed( changes );
+    else if ( changes != NULL )
+        for ( int i = 0; i < sim->pending.count; i++ )
+            mark_cell_changed( changes, sim->pending.tiles[i] / sim->pending.tile_columns * CHANGE_TILE_SIZE,
+                sim->pending.tiles[i] % sim->pending.tile_columns * CHANGE_TILE_SIZE );
+    clear_change_set( &sim->pending );
+    if ( snapshot != NULL )
+    {
+        snapshot->cells = NULL;
+        memset( &snapshot->changes, 0, sizeof( ChangeSet ) );
+        snapshot->generation = latest->generation;
+        snapshot->applied = latest->applied;
+        snapshot->paused = latest->paused;
+        snapshot->rate = latest->rate;
+    }
+    return 1;
+}
+
+
+void stop_simulation( Simulation *sim )
+{
+    __atomic_store_n( &sim->quit, 1, __ATOMIC_RELEASE );
+    pthread_join( sim->thread, NULL );
+    free_engine( &sim->engine );
+    free_simulation_memory( sim );
+}
@@ -0,0 +1,153 @@
+/**
+* @file: simulation.h
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file contains the function prototypes of the simulation thread
+* The simulation runs on its own thread with its own copy of the board. Every completed
+* generation is published through a triple buffer of snapshots, so the UI thread always
+* takes the latest one without waiting, and the edits of the UI thread are sent back
+* through a single producer, single consumer command queue. Neither side takes a lock.
+* The simulation thread lists the tiles that change in every generation, so only these
+* tiles are copied into a snapshot and from a snapshot into the board of the UI.
+* In turbo mode the generations are run in batches that fit in a frame, and only the
+* last generation of each batch is published.
+**/
+
+
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+
+/** Include all the libraries **/
+#include <stdint.h>
+#include <pthread.h>
+#include "board.h"
+#include "engine.h"
+
+
+/** Define all the marcos of the simulation thread **/
+#define SIM_QUEUE_SIZE 4096         // The number of commands the queue can hold, a power of two
+#define SNAPSHOT_FRESH 4            // Set in the shared snapshot index when it holds a generation the UI has not taken
+#define SIM_RATE_UNLIMITED -1       // The turbo rate that runs generations as fast as the engine can
+#define SIM_FRAME_NS 16000000L      // The longest a batch of turbo generations runs before the latest one is published
+#define SIM_RATE_WINDOW_NS 500000000L   // The time the achieved generations per second are measured over
+
+
+/** define all the enums and structs used by the simulation thread **/
+typedef enum
+{
+    SIM_SET_CELL,       // Set the cell at row, col to value
+    SIM_CLEAR,          // Kill every cell and start again from generation 0
+    SIM_PAUSE,          // Stop running generations
+    SIM_RESUME,         // Start running generations
+    SIM_SET_DELAY,      // Wait value milliseconds between two generations
+    SIM_SET_LIMIT,      // Pause when the generation reaches value, 0 for no limit
+    SIM_SET_RATE        // Run value generations per second in batches, SIM_RATE_UNLIMITED as fast as possible, 0 to use the delay
+} SimCommandType;
+
+typedef struct
+{
+    SimCommandType type;    // What to do
+    int row;                // The row of the cell of SIM_SET_CELL
+    int col;                // The column of the cell of SIM_SET_CELL
+    long value;             // The argument of the command
+} SimCommand;
+
+typedef struct
+{
+    Cell *cells;            // The cells of the generation, row after row
+    ChangeSet changes;      // The tiles changed since the last snapshot the UI took
+    uint64_t generation;    // The number of the generation
+    unsigned long applied;  // The number of commands applied before the snapshot was taken
+    int paused;             // 1 if the simulation was paused when the snapshot was taken
+    double rate;            // The generations per second achieved when the snapshot was taken
+} Snapshot;
+
+typedef struct
+{
+    Board board;                        // The board of the simulation thread
+    Engine engine;                      // The engine stepping the board
+    EngineType type;                    // The type of the engine
+    Snapshot snapshots[3];              // The triple buffer of completed generations
+    int back;                           // The snapshot the simulation thread writes, owned by it
+    int middle;                         // The snapshot in between, with SNAPSHOT_FRESH when it is new
+    int front;                          // The snapshot the UI thread reads, owned by it
+    ChangeSet changes;                  // The tiles changed since the last snapshot was published
+    ChangeSet stale[3];                 // The tiles of each snapshot that are older than the board
+    ChangeSet unseen;                   // The tiles of the last published snapshot, for when the UI does not take it
+    ChangeSet pending;                  // The tiles of the snapshots the UI skipped, owned by the UI thread
+    SimCommand queue[SIM_QUEUE_SIZE];   // The commands sent by the UI thread
+    unsigned long head;                 // The number of commands sent, written by the UI thread
+    unsigned long tail;                 // The number of commands applied, written by the simulation thread
+    pthread_t thread;                   // The simulation thread
+    int quit;                           // Set by the UI thread to stop the simulation thread
+    int paused;                         // 1 while no generation is run
+    long delay;                         // The milliseconds between two generations
+    uint64_t generation;                // The number of generations run
+    uint64_t limit;                     // The generation to pause at, 0 for no limit
+    long rate;                          // The target generations per second of turbo mode, 0 when it is off
+    double achieved_rate;               // The generations per second measured over the last window
+    int64_t window_start;               // The start of the current measuring window, 0 if it has to be started
+    uint64_t window_generation;         // The generation at the start of the current measuring window
+} Simulation;
+
+
+/** Declare all the function prototypes **/
+/* Copy a board and start the simulation thread on it, the simulation starts paused
+    *
+    * @param sim: the simulation to be started
+    * @param board: the board to be simulated, it is copied and not used by the thread
+    * @param type: the engine stepping the board
+    *
+    * @return: EXIT_SUCCESS if the thread is started successfully, EXIT_FAILURE otherwise
+*/
+int start_simulation( Simulation *sim, Board *board, EngineType type );
+
+/* Send a command to the simulation thread, it is applied before the next generation
+    *
+    * @param sim: the simulation
+    * @param type: the command
+    * @param row: the row of the cell of SIM_SET_CELL
+    * @param col: the column of the cell of SIM_SET_CELL
+    * @param value: the argument of the command
+    *
+    * @return: EXIT_SUCCESS if the command is queued, EXIT_FAILURE if the queue is full
+*/
+int send_simulation_command( Simulation *sim, SimCommandType type, int row, int col, long value );
+
+/* Copy the latest completed generation into a board if there is a new one, it never waits
+    * Only the tiles changed since the last generation copied are copied.
+    * A generation taken before every sent command was applied is skipped, as the board already has the edits
+    *
+    * @param sim: the simulation
+    * @param board: the board of the UI thread, the same size as the simulated one
+    * @param changes: receives the tiles copied into the board, NULL to not track them
+    * @param snapshot: receives the generation, paused state and applied commands of the copy, can be NULL
+    *
+    * @return: 1 if a new generation is copied, 0 otherwise
+*/
+int receive_snapshot( Simulation *sim, Board *board, ChangeSet *changes, Snapshot *snapshot );
+
+/* Stop the simulation thread and free the simulation
+    *
+    * @param sim: the simulation to be stopped
+    *
+    * @return: none
+*/
+void stop_simulation( Simulation *sim );
+
+
+#endif
@@ -0,0 +1,377 @@
+/**
+* @file: sparse.c
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file contains all the functions of the unbounded sparse universe
+* All the according function prototypes are defined in sparse.h
+**/
+
+/** Head files **/
+#include "sparse.h"
+
+
+/** Define the parameters of the hash map **/
+#define INITIAL_BUCKETS 1024    // The number of buckets of a new hash map
+
+
+/* Get the chunk coordinate of a cell coordinate, rounding towards negative infinity */
+static int64_t chunk_of( int64_t v )
+{
+    return v >= 0 ? v / CHUNK_SIZE : -( -( v + 1 ) / CHUNK_SIZE ) - 1;
+}
+
+/* Hash the coordinates of a chunk */
+static size_t hash_chunk( int64_t x, int64_t y )
+{
+    uint64_t h = ( uint64_t )x * 0x9E3779B97F4A7C15ULL ^ ( uint64_t )y * 0xC2B2AE3D27D4EB4FULL;
+    return ( size_t )( h ^ ( h >> 32 ) );
+}
+
+/* Find the chunk at the given chunk coordinates, NULL if it is not allocated */
+static Chunk *find_chunk( SparseUniverse *su, int64_t x, int64_t y )
+{
+    for ( Chunk *c = su->buckets[hash_chunk( x, y ) & ( su->bucket_count - 1 )]; c != NULL; c = c->chain )
+    {
+        if ( c->x == x && c->y == y )
+            return c;
+    }
+    return NULL;
+}
+
+/* Double the number of buckets of the hash map */
+static void grow_buckets( SparseUniverse *su )
+{
+    size_t count = su->bucket_count * 2;
+    Chunk **buckets = ( Chunk** )calloc( count, sizeof( Chunk* ) );
+    if ( buckets == NULL )
+        return;     // Longer chains are slower but still correct
+    for ( size_t i = 0; i < su->chunk_count; i++ )
+    {
+        Chunk *c = su->chunks[i];
+        size_t index = hash_chunk( c->x, c->y ) & ( count - 1 );
+        c->chain = buckets[index];
+        buckets[index] = c;
+    }
+    free( su->buckets );
+    su->buckets = buckets;
+    su->bucket_count = count;
+}
+
+/* Create an empty chunk at the given chunk coordinates, it must not exist yet */
+static Chunk *create_chunk( SparseUniverse *su, int64_t x, int64_t y )
+{
+    if ( su->chunk_count == su->chunk_capacity )
+    {
+        size_t capacity = su->chunk_capacity ? su->chunk_capacity * 2 : 64;
+        Chunk **chunks = ( Chunk** )realloc( su->chunks, capacity * sizeof( Chunk* ) );
+        if ( chunks == NULL )
+            return NULL;
+        su->chunks = chunks;
+        su->chunk_capacity = capacity;
+    }
+    Chunk *c = ( Chunk* )calloc( 1, sizeof( Chunk ) );
+    if ( c == NULL )
+        return NULL;
+    c->x = x;
+    c->y = y;
+    c->index = su->chunk_count;
+    su->chunks[su->chunk_count++] = c;
+    size_t index = hash_chunk( x, y ) & ( su->bucket_count - 1 );
+    c->chain = su->buckets[index];
+    su->buckets[index] = c;
+    // The chunk is linked first, growing the buckets links every chunk again, this one included
+    if ( su->chunk_count > su->bucket_count )
+        grow_buckets( su );
+    return c;
+}
+
+/* Find a chunk, or create it if it does not exist */
+static Chunk *get_or_create_chunk( SparseUniverse *su, int64_t x, int64_t y )
+{
+    Chunk *c = find_chunk( su, x, y );
+    return c != NULL ? c : create_chunk( su, x, y );
+}
+
+/* Remove a chunk from the hash map and the list and free it */
+static void remove_chunk( SparseUniverse *su, Chunk *c )
+{
+    Chunk **link = &su->buckets[hash_chunk( c->x, c->y ) & ( su->bucket_count - 1 )];
+    while ( *link != c )
+        link = &( *link )->chain;
+    *link = c->chain;
+    Chunk *last = su->chunks[--su->chunk_count];
+    su->chunks[c->index] = last;
+    last->index = c->index;
+    free( c );
+}
+
+/* Count the living cells and find the bounding box of all the chunks */
+static void update_bounds( SparseUniverse *su )
+{
+    su->population = 0;
+    su->min_x = su->min_y = INT64_MAX;
+    su->max_x = su->max_y = INT64_MIN;
+    for ( size_t i = 0; i < su->chunk_count; i++ )
+    {
+        Chunk *c = su->chunks[i];
+        uint64_t columns = 0;
+        int top = -1, bottom = -1;
+        for ( int r = 0; r < CHUNK_SIZE; r++ )
+        {
+            if ( c->cells[r] == 0 )
+                continue;
+            su->population += ( uint64_t )__builtin_popcountll( c->cells[r] );
+            columns |= c->cells[r];
+            if ( top < 0 )
+                top = r;
+            bottom = r;
+        }
+        if ( columns == 0 )
+            continue;
+        int64_t x = c->x * CHUNK_SIZE, y = c->y * CHUNK_SIZE;
+        if ( x + __builtin_ctzll( columns ) < su->min_x )
+            su->min_x = x + __builtin_ctzll( columns );
+        if ( x + 63 - __builtin_clzll( columns ) > su->max_x )
+            su->max_x = x + 63 - __builtin_clzll( columns );
+        if ( y + top < su->min_y )
+            su->min_y = y + top;
+        if ( y + bottom > su->max_y )
+            su->max_y = y + bottom;
+    }
+}
+
+size_t get_sparse_memory( SparseUniverse *su )
+{
+    return su->chunk_count * sizeof( Chunk ) + su->bucket_count * sizeof( Chunk* ) +
+        su->chunk_capacity * sizeof( Chunk* );
+}
+
+int init_sparse_universe( SparseUniverse *su )
+{
+    if ( su == NULL )
+        return EXIT_FAILURE;
+    memset( su, 0, sizeof( SparseUniverse ) );
+    su->rule = RULE_CONWAY;
+    su->bucket_count = INITIAL_BUCKETS;
+    su->buckets = ( Chunk** )calloc( su->bucket_count, sizeof( Chunk* ) );
+    if ( su->buckets == NULL )
+    {
+        fprintf( stderr, "[Err] Unable to allocate the chunks of a sparse universe\n" );
+        return EXIT_FAILURE;
+    }
+    update_bounds( su );
+    return EXIT_SUCCESS;
+}
+
+void free_sparse_universe( SparseUniverse *su )
+{
+    if ( su == NULL || su->buckets == NULL )
+        return;
+    for ( size_t i = 0; i < su->chunk_count; i++ )
+        free( su->chunks[i] );
+    free( su->chunks );
+    free( su->buckets );
+    su->chunks = NULL;
+    su->buckets = NULL;
+    su->chunk_count = su->chunk_capacity = su->bucket_count = 0;
+}
+
+int get_sparse_cell( SparseUniverse *su, int64_t x, int64_t y )
+{
+    Chunk *c = find_chunk( su, chunk_of( x ), chunk_of( y ) );
+    if ( c == NULL )
+        return 0;
+    return ( int )( ( c->cells[y - c->y * CHUNK_SIZE] >> ( x - c->x * CHUNK_SIZE ) ) & 1 );
+}
+
+int set_sparse_cell( SparseUniverse *su, int64_t x, int64_t y, int alive )
+{
+    if ( su == NULL || su->buckets == NULL )
+        return EXIT_FAILURE;
+    Chunk *c = alive ? get_or_create_chunk( su, chunk_of( x ), chunk_of( y ) ) : find_chunk( su, chunk_of( x ), chunk_of( y ) );
+    if ( c == NULL )
+        return alive ? EXIT_FAILURE : EXIT_SUCCESS;
+    uint64_t *word = &c->cells[y - c->y * CHUNK_SIZE];
+    uint64_t bit = ( uint64_t )1 << ( x - c->x * CHUNK_SIZE );
+    if ( alive && !( *word & bit ) )
+    {
+        *word |= bit;
+        su->population++;
+        // A dead cell only shrinks the bounding box at the next generation
+        su->min_x = x < su->min_x ? x : su->min_x;
+        su->max_x = x > su->max_x ? x : su->max_x;
+        su->min_y = y < su->min_y ? y : su->min_y;
+        su->max_y = y > su->max_y ? y : su->max_y;
+    }
+    else if ( !alive && ( *word & bit ) )
+    {
+        *word &= ~bit;
+        su->population--;
+    }
+    return EXIT_SUCCESS;
+}
+
+int load_sparse_from_board( SparseUniverse *su, Board *board )
+{
+    if ( su == NULL || board == NULL || board->grid == NULL )
+        return EXIT_FAILURE;
+    if ( init_sparse_universe( su ) == EXIT_FAILURE )
+        return EXIT_FAILURE;
+    su->rule = board->rule;
+    for ( int y0 = 0; y0 < board->rows; y0 += CHUNK_SIZE )
+    {
+        for ( int x0 = 0; x0 < board->columns; x0 += CHUNK_SIZE )
+        {
+            // Only the chunks with living cells are allocated
+            uint64_t rows[CHUNK_SIZE] = { 0 }, any = 0;
+            for ( int r = 0; r < CHUNK_SIZE && y0 + r < board->rows; r++ )
+            {
+                for ( int col = 0; col < CHUNK_SIZE && x0 + col < board->columns; col++ )
+                {
+                    if ( board->grid[y0 + r][x0 + col] )
+                        rows[r] |= ( uint64_t )1 << col;
+                }
+                any |= rows[r];
+            }
+            if ( any == 0 )
+                continue;
+            Chunk *c = create_chunk( su, x0 / CHUNK_SIZE, y0 / CHUNK_SIZE );
+            if ( c == NULL )
+            {
+                fprintf( stderr, "[Err] Unable to allocate the chunks of a sparse universe\n" );
+                free_sparse_universe( su );
+                return EXIT_FAILURE;
+            }
+            memcpy( c->cells, rows, sizeof( rows ) );
+        }
+    }
+    update_bounds( su );
+    return EXIT_SUCCESS;
+}
+
+int store_sparse_to_board( SparseUniverse *su, Board *board )
+{
+    if ( su == NULL || board == NULL || board->grid == NULL )
+        return EXIT_FAILURE;
+    clear_all_cells( board );
+    for ( size_t i = 0; i < su->chunk_count; i++ )
+    {
+        Chunk *c = su->chunks[i];
+        int64_t x0 = c->x * CHUNK_SIZE, y0 = c->y * CHUNK_SIZE;
+        if ( x0 >= board->columns || y0 >= board->rows || x0 + CHUNK_SIZE <= 0 || y0 + CHUNK_SIZE <= 0 )
+            continue;
+        for ( int r = 0; r < CHUNK_SIZE; r++ )
+        {
+            if ( c->cells[r] == 0 || y0 + r < 0 || y0 + r >= board->rows )
+                continue;
+            for ( int col = 0; col < CHUNK_SIZE; col++ )
+            {
+                if ( x0 + col >= 0 && x0 + col < board->columns && ( ( c->cells[r] >> col ) & 1 ) )
+                    board->grid[y0 + r][x0 + col] = 1;
+            }
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+/* Create the neighbours that living cells on the border of a chunk can spread into */
+static int expand_chunk( SparseUniverse *su, Chunk *c )
+{
+    uint64_t west = 0, east = 0;
+    for ( int r = 0; r < CHUNK_SIZE; r++ )
+    {
+        west |= c->cells[r] & 1;
+        east |= c->cells[r] >> 63;
+    }
+    int north = c->cells[0] != 0, south = c->cells[CHUNK_SIZE - 1] != 0;
+    int need[3][3] = {
+        { ( int )( c->cells[0] & 1 ), north, ( int )( c->cells[0] >> 63 ) },
+        { ( int )west, 0, ( int )east },
+        { ( int )( c->cells[CHUNK_SIZE - 1] & 1 ), south, ( int )( c->cells[CHUNK_SIZE - 1] >> 63 ) } };
+    for ( int dy = -1; dy <= 1; dy++ )
+    {
+        for ( int dx = -1; dx <= 1; dx++ )
+        {
+            if ( need[dy + 1][dx + 1] && get_or_create_chunk( su, c->x + dx, c->y + dy ) == NULL )
+                return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+/* Get a row of a chunk that may not exist */
+static uint64_t chunk_row( Chunk *c, int r )
+{
+    return c == NULL ? 0 : c->cells[r];
+}
+
+/* Write the next generation of a chunk into its back buffer */
+static void step_chunk( SparseUniverse *su, Chunk *c )
+{
+    Chunk *n[3][3];
+    for ( int dy = -1; dy <= 1; dy++ )
+        for ( int dx = -1; dx <= 1; dx++ )
+            n[dy + 1][dx + 1] = dx == 0 && dy == 0 ? c : find_chunk( su, c->x + dx, c->y + dy );
+    for ( int r = 0; r < CHUNK_SIZE; r++ )
+    {
+        // The rows above and below come from the chunks above and below on the first and last row
+        Chunk **above = r == 0 ? n[0] : n[1], **below = r == CHUNK_SIZE - 1 ? n[2] : n[1];
+        int ra = r == 0 ? CHUNK_SIZE - 1 : r - 1, rb = r == CHUNK_SIZE - 1 ? 0 : r + 1;
+        if ( su->rule == RULE_CONWAY )
+            c->next[r] = step_bitboard_word(
+                chunk_row( above[0], ra ), chunk_row( above[1], ra ), chunk_row( above[2], ra ),
+                chunk_row( n[1][0], r ), c->cells[r], chunk_row( n[1][2], r ),
+                chunk_row( below[0], rb ), chunk_row( below[1], rb ), chunk_row( below[2], rb ) );
+        else
+            c->next[r] = step_bitboard_word_rule(
+                chunk_row( above[0], ra ), chunk_row( above[1], ra ), chunk_row( above[2], ra ),
+                chunk_row( n[1][0], r ), c->cells[r], chunk_row( n[1][2], r ),
+                chunk_row( below[0], rb ), chunk_row( below[1], rb ), chunk_row( below[2], rb ), su->rule );
+    }
+}
+
+int update_next_generation_sparse( SparseUniverse *su )
+{
+    if ( su == NULL || su->buckets == NULL )
+        return EXIT_FAILURE;
+    // The chunks created here are empty, so they never need neighbours themselves
+    size_t count = su->chunk_count;
+    for ( size_t i = 0; i < count; i++ )
+    {
+        if ( expand_chunk( su, su->chunks[i] ) == EXIT_FAILURE )
+        {
+            fprintf( stderr, "[Err] Unable to allocate the chunks of a sparse universe\n" );
+            return EXIT_FAILURE;
+        }
+    }
+    for ( size_t i = 0; i < su->chunk_count; i++ )
+        step_chunk( su, su->chunks[i] );
+    // Every chunk is computed before any of them is changed, then the empty ones are freed
+    for ( size_t i = su->chunk_count; i-- > 0; )
+    {
+        Chunk *c = su->chunks[i];
+        uint64_t any = 0;
+        for ( int r = 0; r < CHUNK_SIZE; r++ )
+            any |= c->next[r];
+        if ( any == 0 )
+            remove_chunk( su, c );
+        else
+            memcpy( c->cells, c->next, sizeof( c->cells ) );
+    }
+    update_bounds( su );
+    su->generation++;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,138 @@
+/**
+* @file: sparse.h
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file contains the function prototypes of the unbounded sparse universe
+* The universe has no edges, only the 64x64 chunks around living cells are allocated.
+* They are kept in a hash map keyed by their 64 bit chunk coordinates, a chunk is created
+* when living cells reach the border of a neighbouring chunk and freed when it is empty,
+* so the memory follows the living cells instead of the area they cover.
+**/
+
+
+#ifndef SPARSE_H
+#define SPARSE_H
+
+
+/** Include all the libraries **/
+#include <stdint.h>
+#include "bitboard.h"
+
+
+/** Define all the marcos of the sparse universe **/
+#define CHUNK_SIZE CELLS_PER_WORD   // A chunk is 64 x 64 cells, one word per row
+
+
+/** define all the structs used in the sparse universe **/
+typedef struct Chunk
+{
+    int64_t x;                      // The chunk column, the chunk covers the cells 64 * x to 64 * x + 63
+    int64_t y;                      // The chunk row
+    uint64_t cells[CHUNK_SIZE];     // The current generation, one word per row
+    uint64_t next[CHUNK_SIZE];      // The buffer the next generation is written into
+    struct Chunk *chain;            // The next chunk in the same bucket of the hash map
+    size_t index;                   // The position of the chunk in the list of chunks
+} Chunk;
+
+typedef struct
+{
+    Chunk **buckets;                // The hash map of the chunks
+    size_t bucket_count;            // The number of buckets, always a power of two
+    Chunk **chunks;                 // Every chunk, in no particular order
+    size_t chunk_count;             // The number of chunks
+    size_t chunk_capacity;          // The capacity of the list of chunks
+    uint64_t population;            // The number of living cells
+    int64_t min_x, min_y;           // The top left living cell of the bounding box
+    int64_t max_x, max_y;           // The bottom right living cell, the box is empty if max_x < min_x
+    uint64_t generation;            // The number of generations simulated so far
+    uint32_t rule;                  // The rule of the universe, B3/S23 unless it is loaded from a board with another one
+} SparseUniverse;
+
+
+/** Declare all the function prototypes **/
+/* Initialize an empty sparse universe
+    *
+    * @param su: the universe to be initialized
+    *
+    * @return: EXIT_SUCCESS if the universe is initialized successfully, EXIT_FAILURE otherwise
+*/
+int init_sparse_universe( SparseUniverse *su );
+
+/* Free every chunk of a sparse universe
+    *
+    * @param su: the universe to be freed
+    *
+    * @return: none
+*/
+void free_sparse_universe( SparseUniverse *su );
+
+/* Get the state of a cell
+    *
+    * @param su: the universe
+    * @param x: the column of the cell
+    * @param y: the row of the cell
+    *
+    * @return: 1 if the cell is alive, 0 otherwise
+*/
+int get_sparse_cell( SparseUniverse *su, int64_t x, int64_t y );
+
+/* Set the state of a cell, the chunk of a living cell is created if it does not exist
+    *
+    * @param su: the universe
+    * @param x: the column of the cell
+    * @param y: the row of the cell
+    * @param alive: 1 to make the cell alive, 0 to kill it
+    *
+    * @return: EXIT_SUCCESS if the cell is set successfully, EXIT_FAILURE otherwise
+*/
+int set_sparse_cell( SparseUniverse *su, int64_t x, int64_t y, int alive );
+
+/* Initialize a sparse universe with the cells of a board, the top left cell of the board is (0, 0)
+    *
+    * @param su: the universe to be initialized
+    * @param board: the board to be loaded
+    *
+    * @return: EXIT_SUCCESS if the board is loaded successfully, EXIT_FAILURE otherwise
+*/
+int load_sparse_from_board( SparseUniverse *su, Board *board );
+
+/* Write the cells of the universe that are inside the board back to the board
+    *
+    * @param su: the universe
+    * @param board: the board that receives the cells
+    *
+    * @return: EXIT_SUCCESS if the board is written successfully, EXIT_FAILURE otherwise
+*/
+int store_sparse_to_board( SparseUniverse *su, Board *board );
+
+/* Update the sparse universe to the next generation, chunks are created and freed as needed
+    *
+    * @param su: the universe to be updated
+    *
+    * @return: EXIT_SUCCESS if the universe is updated successfully, EXIT_FAILURE otherwise
+*/
+int update_next_generation_sparse( SparseUniverse *su );
+
+/* Get the number of bytes used by the chunks and the hash map
+    *
+    * @param su: the universe
+    *
+    * @return: the number of bytes
+*/
+size_t get_sparse_memory( SparseUniverse *su );
+
+
+#endif
@@ -0,0 +1,108 @@
+/**
+* @file: tiles.c
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file contains all the functions of the active region tracking
+* All the according function prototypes are defined in tiles.h
+**/
+
+/** Head files **/
+#include "tiles.h"
+
+
+int init_tile_map( TileMap *tm, BitBoard *bb )
+{
+    if ( tm == NULL || bb == NULL || bb->cells == NULL )
+        return EXIT_FAILURE;
+    tm->tile_rows = ( bb->rows + TILE_ROWS - 1 ) / TILE_ROWS;
+    tm->tile_columns = ( bb->words_per_row + TILE_WORDS - 1 ) / TILE_WORDS;
+    size_t tiles = ( size_t )tm->tile_rows * tm->tile_columns;
+    tm->memory = ( unsigned char* )malloc( 2 * tiles );
+    if ( tm->memory == NULL )
+    {
+        fprintf( stderr, "[Err] Unable to allocate the tiles of a %d x %d board\n", bb->rows, bb->columns );
+        return EXIT_FAILURE;
+    }
+    // The back buffer does not hold the previous generation yet, so every tile is computed once
+    tm->changed = tm->memory;
+    tm->next_changed = tm->memory + tiles;
+    memset( tm->changed, 1, tiles );
+    tm->computed = tm->skipped = 0;
+    return EXIT_SUCCESS;
+}
+
+void free_tile_map( TileMap *tm )
+{
+    if ( tm == NULL )
+        return;
+    free( tm->memory );
+    tm->memory = tm->changed = tm->next_changed = NULL;
+}
+
+void mark_tile_changed( TileMap *tm, int row, int col )
+{
+    int tile_row = row / TILE_ROWS, tile_col = col / CELLS_PER_WORD / TILE_WORDS;
+    if ( tile_row >= 0 && tile_row < tm->tile_rows && tile_col >= 0 && tile_col < tm->tile_columns )
+        tm->changed[( size_t )tile_row * tm->tile_columns + tile_col] = 1;
+}
+
+/* Check whether a tile or one of its neighbours changed in the last generation */
+static int is_tile_active( TileMap *tm, int tile_row, int tile_col )
+{
+    for ( int r = tile_row - 1; r <= tile_row + 1; r++ )
+    {
+        if ( r < 0 || r >= tm->tile_rows )
+            continue;
+        const unsigned char *flags = tm->changed + ( size_t )r * tm->tile_columns;
+        for ( int c = tile_col - 1; c <= tile_col + 1; c++ )
+        {
+            if ( c >= 0 && c < tm->tile_columns && flags[c] )
+                return 1;
+        }
+    }
+    return 0;
+}
+
+int update_next_generation_tiled( BitBoard *bb, TileMap *tm )
+{
+    if ( bb == NULL || bb->cells == NULL || tm == NULL || tm->memory == NULL )
+        return EXIT_FAILURE;
+    for ( int r = 0; r < tm->tile_rows; r++ )
+    {
+        int first_row = r * TILE_ROWS;
+        int last_row = first_row + TILE_ROWS < bb->rows ? first_row + TILE_ROWS : bb->rows;
+        for ( int c = 0; c < tm->tile_columns; c++ )
+        {
+            unsigned char *flag = &tm->next_changed[( size_t )r * tm->tile_columns + c];
+            if ( !is_tile_active( tm, r, c ) )
+            {
+                // The tile is the same in both buffers, and stays the same
+                *flag = 0;
+                tm->skipped++;
+                continue;
+            }
+            int first_word = c * TILE_WORDS;
+            int last_word = first_word + TILE_WORDS < bb->words_per_row ? first_word + TILE_WORDS : bb->words_per_row;
+            *flag = ( unsigned char )update_bitboard_block( bb, first_row, last_row, first_word, last_word );
+            tm->computed++;
+        }
+    }
+    swap_bitboard( bb );
+    unsigned char *swap = tm->changed;
+    tm->changed = tm->next_changed;
+    tm->next_changed = swap;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,90 @@
+/**
+* @file: tiles.h
+*
+* This program is the implementation of Conway's Game of Life in C
+* This program uses the SDL2 library to display all the content and views
+*
+* Run the main program with "sh run.sh"
+* This command will auto compile the program using the Makefile,
+* and run the program "./build/debug/exe"
+*
+* Authorship:       Yuelin Xin
+* Affiliation:      School of Computing, University of Leeds
+* Organization:     MiracleFactory
+* Organization URL: https://www.miraclefactory.co/
+**/
+
+/**
+* This file contains the function prototypes of the active region tracking
+* The bit-packed board is divided into tiles, and a tile is only recomputed when it or
+* one of its eight neighbours changed in the last generation. A tile that is skipped did
+* not change, so the back buffer already holds its cells and nothing has to be copied.
+**/
+
+
+#ifndef TILES_H
+#define TILES_H
+
+
+/** Include all the libraries **/
+#include "bitboard.h"
+
+
+/** Define all the marcos of the tiles **/
+#define TILE_ROWS 64            // The number of rows in a tile
+#define TILE_WORDS 1            // The number of words in each row of a tile, 64 columns each
+
+
+/** define all the structs used in the active region tracking **/
+typedef struct
+{
+    int tile_rows;              // The number of rows of tiles
+    int tile_columns;           // The number of columns of tiles
+    unsigned char *changed;     // The tiles that changed in the last generation
+    unsigned char *next_changed;// The tiles that change in the generation being computed
+    unsigned char *memory;      // The allocation that holds both sets of flags
+    size_t computed;            // The number of tiles recomputed so far
+    size_t skipped;             // The number of tiles skipped so far
+} TileMap;
+
+
+/** Declare all the function prototypes **/
+/* Initialize the tiles of a bit-packed board, every tile starts as changed
+    *
+    * @param tm: the tiles to be initialized
+    * @param bb: the bit-packed board
+    *
+    * @return: EXIT_SUCCESS if the tiles are initialized successfully, EXIT_FAILURE otherwise
+*/
+int init_tile_map( TileMap *tm, BitBoard *bb );
+
+/* Free the memory held by the tiles
+    *
+    * @param tm: the tiles to be freed
+    *
+    * @return: none
+*/
+void free_tile_map( TileMap *tm );
+
+/* Mark the tile of a cell as changed, this has to be called after a cell is edited
+    *
+    * @param tm: the tiles
+    * @param row: the row of the edited cell
+    * @param col: the column of the edited cell
+    *
+    * @return: none
+*/
+void mark_tile_changed( TileMap *tm, int row, int col );
+
+/* Update the bit-packed board to the next generation, only the tiles around a change are recomputed
+    * The result is the same as update_next_generation_bitboard
+    *
+    * @param bb: the bit-packed board to be updated
+    * @param tm: the tiles of the board
+    *
+    * @return: EXIT_SUCCESS if the board is updated successfully, EXIT_FAILURE otherwise
+*/
+int update_next_generation_tiled( BitBoard *bb, TileMap *tm );
+
+
+#endif
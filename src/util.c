@@ -24,66 +24,10 @@
 #include "util.h"
 
 
-int read_bin( char *filename, unsigned int *buffer, int rows, int cols )
+int render_button( AssetCache *assets, int button, int x, int y )
 {
-    // Open binary file
-    FILE *fp = fopen( filename, "rb" );
-    if ( fp == NULL )
-    {
-        fprintf( stderr, File_IO_Err );
-        return EXIT_FAILURE;
-    }
-    buffer = malloc( rows * cols * sizeof( unsigned char ) );
-    fread( buffer, sizeof( buffer ), 1, fp );
-    for ( int i = 0; i < 10; i++ )
-    {
-        printf( "%d ", buffer[i] );
-    }
-    fclose( fp );
-    return EXIT_SUCCESS;
-}
-
-int write_bin( char *filename, unsigned int *buffer, int rows, int cols )
-{
-    // Open binary file
-    FILE *fp = fopen( filename, "wb" );
-    if ( fp == NULL )
-    {
-        fprintf( stderr, File_IO_Err );
-        return EXIT_FAILURE;
-    }
-    fwrite( buffer, sizeof( buffer ), 1, fp );
-    fclose( fp );
-    return EXIT_SUCCESS;
-}
-
-int render_text( SDL_Renderer *rend, TTF_Font* smooth_operator, SDL_Color color, char *text, int x, int y )
-{
-    SDL_Surface *surface_smooth_operator = TTF_RenderText_Blended( smooth_operator, text, color );
-    SDL_Texture* Message = SDL_CreateTextureFromSurface( rend, surface_smooth_operator );
-    int w, h;
-    SDL_QueryTexture( Message, NULL, NULL, &w, &h );
-    SDL_Rect rect = {x, y, w, h};
-    SDL_RenderCopy(rend, Message, NULL, &rect);
-    SDL_FreeSurface( surface_smooth_operator );
-    SDL_DestroyTexture( Message );
-    return EXIT_SUCCESS;
-}
-
-int render_button( SDL_Renderer *rend, const char *file, int x, int y )
-{
-    SDL_Surface *surface_button = IMG_Load( file );
-    if ( surface_button == NULL )
-    {
-        fprintf( stderr, "[Err] Unable to load image %s! SDL_image Error: %s\n", file, IMG_GetError() );
-        return EXIT_FAILURE;
-    }
-    SDL_Texture* Button = SDL_CreateTextureFromSurface( rend, surface_button );
-    SDL_Rect rect = {x, y, 24, 24};
-    SDL_RenderCopy(rend, Button, NULL, &rect);
-    SDL_FreeSurface( surface_button );
-    SDL_DestroyTexture( Button );
-    return EXIT_SUCCESS;
+    // The image was loaded once by the cache, this is only a copy of the resident texture
+    return draw_asset( assets, button, x, y, 24, 24 );
 }
 
 int number_input( void )
@@ -24,58 +24,26 @@
 #define UTIL_H
 
 
+/** Include all the libraries **/
+#include "assets.h"
+
+
 /** Define all the functional marcos **/
 #define FALSE 0
 #define TRUE 1
-#define File_IO_Err "[Err] File could not be accessed, check:\n-> Does file exist?\n-> Directory/file name correct?\n-> Is file corrupted?\n"
 
 
 /** Declare all the function prototypes **/
-/* Read binary files to the int buffer 
-    *
-    * @param filename: the name of the file to be read
-    * @param buffer: the buffer to store the data
-    * @param rows: the number of rows in the file
-    * @param cols: the number of columns in the file
-    *
-    * @return: EXIT_SUCCESS if the file is read successfully, EXIT_FAILURE otherwise
-*/
-int read_bin( char *filename, unsigned int *buffer, int rows, int cols );
-
-/* Write binary files from the int buffer 
-    *
-    * @param filename: the name of the file to be written
-    * @param buffer: the buffer to store the data
-    * @param rows: the number of rows in the file
-    * @param cols: the number of columns in the file
-    *
-    * @return: EXIT_SUCCESS if the file is written successfully, EXIT_FAILURE otherwise
-*/
-int write_bin( char *filename, unsigned int *buffer, int rows, int cols );
-
-/* Render text onto the screen
-    *
-    * @param rend: the renderer to render the text
-    * @param smooth_operator: the font of the text
-    * @param color: the SDL color of the text
-    * @param text: the pointer to the text to be rendered
-    * @param x: the x coordinate of the text
-    * @param y: the y coordinate of the text
-    *
-    * @return: EXIT_SUCCESS if the text is rendered successfully
-*/
-int render_text( SDL_Renderer *rend, TTF_Font* smooth_operator, SDL_Color color, char *text, int x, int y );
-
-/* Render text onto the screen
+/* Render a button onto the screen
     *
-    * @param rend: the renderer to render the text
-    * @param file: the image file to be rendered
-    * @param x: the x coordinate of the text
-    * @param y: the y coordinate of the text
+    * @param assets: the image cache that holds the button
+    * @param button: the handle of the button image in the cache
+    * @param x: the x coordinate of the button
+    * @param y: the y coordinate of the button
     *
-    * @return: EXIT_SUCCESS if the text is rendered successfully
+    * @return: EXIT_SUCCESS if the button is rendered successfully, EXIT_FAILURE otherwise
 */
-int render_button( SDL_Renderer *rend, const char *file, int x, int y );
+int render_button( AssetCache *assets, int button, int x, int y );
 
 /* Get the number input from the user
     *
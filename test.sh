@@ -17,5 +17,5 @@
 # ===========================================================================
 
 
-gcc -o build/debug/test unit_test.c -Iinclude lib/CUnit/libcunit.a
+gcc -o build/debug/test unit_test.c src/board.c src/rule.c src/binfile.c src/pattern.c src/autosave.c src/cycle.c src/changes.c src/bitboard.c src/pool.c src/simd.c src/hashlife.c src/tiles.c src/sparse.c src/lookup.c src/engine.c src/simulation.c src/profiler.c -Iinclude lib/CUnit/libcunit.a -lpthread
 ./build/debug/test
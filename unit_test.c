@@ -21,178 +21,48 @@
 /** Head files **/
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
 #include "include/CUnit/Basic.h"
 #include "src/game.h"
+#include "src/board.h"
 #include "src/util.h"
+#include "src/bitboard.h"
+#include "src/engine.h"
+#include "src/hashlife.h"
+#include "src/tiles.h"
+#include "src/sparse.h"
+#include "src/simulation.h"
+#include "src/binfile.h"
+#include "src/pattern.h"
+#include "src/autosave.h"
+#include "src/cycle.h"
+#include "src/lookup.h"
+#include "src/profiler.h"
 #include "unit_test.h"
 
 
-
 /** All the tested functions are here **/
-// Test function 1: clear_all_cells
-int clear_all_cells( Board *b )
-{
-    if ( b == NULL )
-        return EXIT_FAILURE;
-    for ( int i = 0; i < b->rows; i++ )
-    {
-        for ( int j = 0; j < b->columns; j++ )
-        {
-            b->grid[i][j] = 0;
-        }
-    }
-    return EXIT_SUCCESS;
-}
-
-// Test function 2: init_view
+// Test function 1: init_view (game.c needs SDL to link, so the function is copied here)
 int init_view( Window *view, Board *board )
 {
     if ( view == NULL || board == NULL )
         return EXIT_FAILURE;
-    view->cell_size = 17;
-    view->window_height = ( view->cell_size * board->rows ) + 40;
-    view->window_width = view->cell_size * board->columns;
-    view->height_in_cells = view->window_height / view->cell_size;
+    view->cell_size = DEFAULT_CELL_SIZE;
+    // The window never grows past the maximum view, larger boards are scrolled with the camera
+    long long board_width = ( long long )view->cell_size * board->columns;
+    long long board_height = ( long long )view->cell_size * board->rows;
+    view->window_width = board_width < MAX_VIEW_WIDTH ? ( int )board_width : MAX_VIEW_WIDTH;
+    view->window_height = ( board_height < MAX_VIEW_HEIGHT ? ( int )board_height : MAX_VIEW_HEIGHT ) + HUD_HEIGHT;
+    view->height_in_cells = ( view->window_height - HUD_HEIGHT ) / view->cell_size;
     view->width_in_cells = view->window_width / view->cell_size;
     view->movement_speed_in_cells = 3;
     view->min_movement_speed_in_pixels = view->movement_speed_in_cells * view->cell_size;
-    const int BOARD_HEIGHT = view->window_height / 4;
-    const int BOARD_WIDTH = view->window_width / 4;
-    view->camera_x = ( BOARD_WIDTH - view->width_in_cells ) / 2;
-    view->camera_y = ( BOARD_HEIGHT - view->height_in_cells ) / 2;
-    return EXIT_SUCCESS;
-}
-
-// Test function 3: count_neighbors
-inline int count_neighbors( Board *b, int row, int col )
-{
-    if ( b == NULL )
-        return EXIT_FAILURE;
-    if ( row < 0 || row >= b->rows || col < 0 || col >= b->columns )
-        return EXIT_FAILURE;
-    int count = 0;
-    for ( int i = row -1 ; i <= row + 1; i++ )
-    {
-        for ( int j = col - 1; j <= col + 1; j++ )
-        {
-            if ( i == row && j == col )
-                continue;
-            if ( i < 0 || i >= b->rows || j < 0 || j >= b->columns )
-                continue;
-            if ( b->grid[i][j] )
-                count++;
-        }
-    }
-    return count;
-}
-
-// Test function 4: write_back_to_file
-int write_back_to_file( char *config_file, char *data_file, Board *board )
-{
-    // Write config file
-    FILE *config = fopen( config_file, "w" );
-    if ( config == NULL )
-    {
-        return EXIT_FAILURE;
-    }
-    fprintf( config, "rows,cols: (%d,%d)\ndelay: (%d)", board->rows, board->columns, board->delay );
-    fclose( config );
-
-    // Write data file
-    FILE *data = fopen( data_file, "w" );
-    if ( data == NULL )
-    {
-        return EXIT_FAILURE;
-    }
-    for ( int i = 0; i < board->rows; i++ )
-    {
-        for ( int j = 0; j < board->columns; j++ )
-        {
-            fprintf( data, "%d ", board->grid[i][j] );
-        }
-        fprintf( data, "\n" );
-    }
-    fclose( data );
-    return EXIT_SUCCESS;
-}
-
-// Test 5: init_board_by_user
-int init_board_by_user( Board *board )
-{
-    if ( board == NULL )
-        return EXIT_FAILURE;
-    // Initialize the board
-    board->grid = ( int** )malloc( board->rows * sizeof( int* ) );
-    for ( int i = 0; i < board->rows; i++ )
-    {
-        board->grid[i] = ( int* )malloc( board->columns * sizeof( int ) );
-        for( int j = 0; j < board->columns; j++ )
-        {
-            board->grid[i][j] = 0;
-        }
-    }
+    // Start with the camera in the middle of the board
+    view->camera_x = ( board->columns - view->width_in_cells ) / 2;
+    view->camera_y = ( board->rows - view->height_in_cells ) / 2;
     return EXIT_SUCCESS;
 }
 
-// Test function 6: init_board_from_file
-int init_board_from_file( char *config_file, char *data_file, Board *board )
-{
-    // Read rows and cols from config file
-    FILE *config = fopen( config_file, "r" );
-    if ( config == NULL )
-    {
-        return EXIT_FAILURE;
-    }
-    while( !feof( config ) )
-    {
-        fscanf( config, "rows,cols: (%d,%d)\ndelay: (%d)", &board->rows, &board->columns, &board->delay );
-    }
-    fclose( config );
-    // Error checking on the configuraiton
-    if ( board->rows < MIN_ROWS || board->columns < MIN_COLS )
-    {
-        return EXIT_FAILURE;
-    }
-    if ( board->rows > MAX_ROWS || board->columns > MAX_COLS )
-    {
-        return EXIT_FAILURE;
-    }
-    if ( board->delay < MIN_DELAY || board->delay > MAX_DELAY )
-    {
-        return EXIT_FAILURE;
-    }
-
-    // Read data from data file
-    int count = 0;
-    FILE *data = fopen( data_file, "r" );
-    if ( data == NULL )
-    {
-        return EXIT_FAILURE;
-    }
-    board->grid = ( int** )malloc( board->rows * sizeof( int* ) );
-    while( !feof( data ) )
-    {
-        for ( int i = 0; i < board->rows; i++ )
-        {
-            board->grid[i] = ( int* )malloc( board->columns * sizeof( int ) );
-            for( int j = 0; j < board->columns; j++ )
-            {
-                fscanf( data, "%d ", &board->grid[i][j] );
-                count++;
-            }
-        }
-    }
-    if ( count != board->rows * board->columns )
-    {
-        fclose( data );
-        free( board->grid );
-        return 2;
-    }
-    fclose( data );
-    return EXIT_SUCCESS;
-}
-
-
 /** All the test cases here **/
 // Test 1: clear_all_cells
 static void test_clear_all_cells( void )
@@ -215,6 +85,14 @@ static void test_init_view( void )
     Window view;
     CU_ASSERT_EQUAL( init_view( &view, b ), EXIT_SUCCESS );
     free( b );
+    // Test case 3: the window of a very large board is capped and the camera starts in the middle
+    Board large;
+    large.rows = large.columns = 65536;
+    CU_ASSERT_EQUAL( init_view( &view, &large ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( view.window_width, MAX_VIEW_WIDTH );
+    CU_ASSERT_EQUAL( view.window_height, MAX_VIEW_HEIGHT + HUD_HEIGHT );
+    CU_ASSERT_EQUAL( view.camera_x, ( large.columns - view.width_in_cells ) / 2 );
+    CU_ASSERT_EQUAL( view.camera_y, ( large.rows - view.height_in_cells ) / 2 );
 }
 
 // Test 3: count_neighbors
@@ -271,6 +149,1265 @@ static void test_init_board_from_file( void )
     free( b );
 }
 
+// Test 7: update_next_generation_bitboard
+static void test_update_next_generation_bitboard( void )
+{
+    // Test case 1: board is NULL
+    CU_ASSERT_EQUAL( update_next_generation_bitboard( NULL ), EXIT_FAILURE );
+    // Test case 2: the packed board follows count_neighbors, across word boundaries and edges
+    Board *b = tool_create_random_board( 37, 150, 7 );
+    BitBoard bb;
+    CU_ASSERT_EQUAL( load_bitboard_from_board( &bb, b ), EXIT_SUCCESS );
+    int same = TRUE;
+    for ( int gen = 0; gen < 20; gen++ )
+    {
+        tool_step_reference( b );
+        update_next_generation_bitboard( &bb );
+        for ( int i = 0; i < b->rows; i++ )
+            for ( int j = 0; j < b->columns; j++ )
+                if ( get_bitboard_cell( &bb, i, j ) != b->grid[i][j] )
+                    same = FALSE;
+    }
+    CU_ASSERT_TRUE( same );
+    free_bitboard( &bb );
+    free( b );
+}
+
+// Test 8: update_next_generation
+static void test_update_next_generation( void )
+{
+    // Test case 1: the double buffered update follows count_neighbors
+    Board *expected = tool_create_random_board( 20, 33, 11 );
+    Board b;
+    b.rows = expected->rows;
+    b.columns = expected->columns;
+    b.rule = RULE_CONWAY;
+    b.boundary = BOUNDARY_DEAD;
+    CU_ASSERT_EQUAL( init_board_by_user( &b ), EXIT_SUCCESS );
+    for ( int i = 0; i < b.rows; i++ )
+        for ( int j = 0; j < b.columns; j++ )
+            b.grid[i][j] = expected->grid[i][j];
+    // Test case 2: no heap allocation is made while updating, only the update itself is counted
+    size_t allocations = 0;
+    int same = TRUE;
+    for ( int gen = 0; gen < 50; gen++ )
+    {
+        tool_step_reference( expected );
+        size_t before = get_board_allocation_count();
+        int code = update_next_generation( &b );
+        allocations += get_board_allocation_count() - before;
+        CU_ASSERT_EQUAL( code, EXIT_SUCCESS );
+        for ( int i = 0; i < b.rows; i++ )
+            for ( int j = 0; j < b.columns; j++ )
+                if ( b.grid[i][j] != expected->grid[i][j] )
+                    same = FALSE;
+    }
+    CU_ASSERT_TRUE( same );
+    CU_ASSERT_EQUAL( allocations, 0 );
+    // The counter does see the allocations of the board functions, the two blocks of a board
+    size_t before = get_board_allocation_count();
+    Board counted = b;
+    CU_ASSERT_EQUAL( alloc_board( &counted ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( get_board_allocation_count() - before, 2 );
+    free_board( &counted );
+    free_board( &b );
+    free( expected );
+}
+
+// Test 9: the parallel engine
+static void test_parallel_engine( void )
+{
+    // Test case 1: the bands give the same result as the serial bit-packed engine
+    // Test case 2: more threads than rows leaves some threads with an empty band
+    int sizes[2][3] = { { 97, 200, 4 }, { 3, 70, 8 } };
+    for ( int t = 0; t < 2; t++ )
+    {
+        Board *serial = tool_create_random_board( sizes[t][0], sizes[t][1], 5 );
+        Board *parallel = tool_create_random_board( sizes[t][0], sizes[t][1], 5 );
+        Engine serial_engine, parallel_engine;
+        CU_ASSERT_EQUAL( init_engine( &serial_engine, ENGINE_BITBOARD, 1, serial ), EXIT_SUCCESS );
+        CU_ASSERT_EQUAL( init_engine( &parallel_engine, ENGINE_PARALLEL, sizes[t][2], parallel ), EXIT_SUCCESS );
+        CU_ASSERT_EQUAL( step_engine( &serial_engine, 40 ), EXIT_SUCCESS );
+        CU_ASSERT_EQUAL( step_engine( &parallel_engine, 40 ), EXIT_SUCCESS );
+        size_t bytes = ( size_t )serial_engine.bits.rows * serial_engine.bits.words_per_row * sizeof( uint64_t );
+        CU_ASSERT_EQUAL( memcmp( serial_engine.bits.cells, parallel_engine.bits.cells, bytes ), 0 );
+        free_engine( &serial_engine );
+        free_engine( &parallel_engine );
+        free( serial );
+        free( parallel );
+    }
+}
+
+// Test 10: update_next_generation_simd
+static void test_update_next_generation_simd( void )
+{
+    // Test case 1: board is NULL
+    CU_ASSERT_EQUAL( update_next_generation_simd( NULL ), EXIT_FAILURE );
+    // Test case 2: every kernel the CPU supports follows count_neighbors, with a partial last vector
+    for ( int k = SIMD_SCALAR; k <= detect_simd_kernel(); k++ )
+    {
+        CU_ASSERT_EQUAL( select_simd_kernel( k ), EXIT_SUCCESS );
+        Board *b = tool_create_random_board( 41, 77, 3 );
+        SimdBoard sb;
+        CU_ASSERT_EQUAL( load_simd_board_from_board( &sb, b ), EXIT_SUCCESS );
+        int same = TRUE;
+        for ( int gen = 0; gen < 30; gen++ )
+        {
+            tool_step_reference( b );
+            update_next_generation_simd( &sb );
+            for ( int i = 0; i < b->rows; i++ )
+                if ( memcmp( sb.cells + i * sb.stride, b->grid[i], b->columns ) != 0 )
+                    same = FALSE;
+        }
+        CU_ASSERT_TRUE( same );
+        free_simd_board( &sb );
+        free( b );
+    }
+    // Test case 3: a kernel the CPU does not have cannot be selected
+    CU_ASSERT_EQUAL( select_simd_kernel( SIMD_KERNEL_COUNT ), EXIT_FAILURE );
+    select_simd_kernel( detect_simd_kernel() );
+}
+
+// Test 11: step_hashlife
+static void test_step_hashlife( void )
+{
+    // Test case 1: universe is NULL or the step is too large
+    HashLife hl;
+    CU_ASSERT_EQUAL( advance_hashlife( NULL, 0 ), EXIT_FAILURE );
+    CU_ASSERT_EQUAL( load_hashlife_from_board( &hl, NULL, HASHLIFE_DEFAULT_BUDGET ), EXIT_FAILURE );
+    // Test case 2 and 3: a soup in the middle of the board follows count_neighbors, with a tiny cache too
+    size_t budgets[2] = { HASHLIFE_DEFAULT_BUDGET, 1 };
+    for ( int k = 0; k < 2; k++ )
+    {
+        Board *b = tool_create_random_board( 100, 120, 5 );
+        Board *out = tool_create_random_board( 100, 120, 6 );
+        for ( int i = 0; i < b->rows; i++ )
+            for ( int j = 0; j < b->columns; j++ )
+                if ( i < 42 || i >= 58 || j < 52 || j >= 68 )
+                    b->grid[i][j] = 0;
+        CU_ASSERT_EQUAL( load_hashlife_from_board( &hl, b, budgets[k] ), EXIT_SUCCESS );
+        // 37 generations is 1 + 4 + 32, the soup cannot reach the edges of the board in that time
+        CU_ASSERT_EQUAL( step_hashlife( &hl, 37 ), EXIT_SUCCESS );
+        CU_ASSERT_EQUAL( hl.generation, 37 );
+        for ( int gen = 0; gen < 37; gen++ )
+            tool_step_reference( b );
+        CU_ASSERT_EQUAL( store_hashlife_to_board( &hl, out ), EXIT_SUCCESS );
+        int same = TRUE;
+        for ( int i = 0; i < b->rows; i++ )
+            if ( memcmp( out->grid[i], b->grid[i], b->columns ) != 0 )
+                same = FALSE;
+        CU_ASSERT_TRUE( same );
+        if ( k == 1 )
+            CU_ASSERT_TRUE( hl.collections > 0 );
+        free_hashlife( &hl );
+        free( b );
+        free( out );
+    }
+    // Test case 4: a glider moves one cell diagonally every 4 generations, even after 2^40 generations
+    Board *b = tool_create_random_board( 8, 8, 7 );
+    clear_all_cells( b );
+    b->grid[0][1] = b->grid[1][2] = b->grid[2][0] = b->grid[2][1] = b->grid[2][2] = 1;
+    CU_ASSERT_EQUAL( load_hashlife_from_board( &hl, b, HASHLIFE_DEFAULT_BUDGET ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( advance_hashlife( &hl, 40 ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( hl.root->population, 5 );
+    CU_ASSERT_EQUAL( hl.generation, ( uint64_t )1 << 40 );
+    // Move the board with the glider, it has to be in the same phase and place as at the start
+    Board *moved = tool_create_random_board( 8, 8, 8 );
+    hl.origin_x -= ( int64_t )1 << 38;
+    hl.origin_y -= ( int64_t )1 << 38;
+    CU_ASSERT_EQUAL( store_hashlife_to_board( &hl, moved ), EXIT_SUCCESS );
+    int same = TRUE;
+    for ( int i = 0; i < b->rows; i++ )
+        if ( memcmp( moved->grid[i], b->grid[i], b->columns ) != 0 )
+            same = FALSE;
+    CU_ASSERT_TRUE( same );
+    free_hashlife( &hl );
+    free( b );
+    free( moved );
+}
+
+// Test 12: update_next_generation_tiled
+static void test_update_next_generation_tiled( void )
+{
+    // Test case 1: board is NULL
+    TileMap tm;
+    CU_ASSERT_EQUAL( update_next_generation_tiled( NULL, NULL ), EXIT_FAILURE );
+    CU_ASSERT_EQUAL( init_tile_map( &tm, NULL ), EXIT_FAILURE );
+    // Test case 2: a soup in one corner of the board gives the same generations as the full scan
+    Board *b = tool_create_random_board( 300, 200, 9 );
+    for ( int i = 0; i < b->rows; i++ )
+        for ( int j = 0; j < b->columns; j++ )
+            if ( i >= 40 || j >= 50 )
+                b->grid[i][j] = 0;
+    BitBoard full, tiled;
+    CU_ASSERT_EQUAL( load_bitboard_from_board( &full, b ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( load_bitboard_from_board( &tiled, b ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( init_tile_map( &tm, &tiled ), EXIT_SUCCESS );
+    size_t words = ( size_t )full.rows * full.words_per_row;
+    int same = TRUE;
+    for ( int gen = 0; gen < 80; gen++ )
+    {
+        // Test case 3: a cell edited far away from the soup is picked up once its tile is marked
+        if ( gen == 40 )
+        {
+            set_bitboard_cell( &full, 250, 150, 1 );
+            set_bitboard_cell( &full, 250, 151, 1 );
+            set_bitboard_cell( &full, 250, 152, 1 );
+            set_bitboard_cell( &tiled, 250, 150, 1 );
+            set_bitboard_cell( &tiled, 250, 151, 1 );
+            set_bitboard_cell( &tiled, 250, 152, 1 );
+            mark_tile_changed( &tm, 250, 150 );
+            mark_tile_changed( &tm, 250, 152 );
+        }
+        update_next_generation_bitboard( &full );
+        CU_ASSERT_EQUAL( update_next_generation_tiled( &tiled, &tm ), EXIT_SUCCESS );
+        if ( memcmp( full.cells, tiled.cells, words * sizeof( uint64_t ) ) != 0 )
+            same = FALSE;
+    }
+    CU_ASSERT_TRUE( same );
+    CU_ASSERT_EQUAL( tm.computed + tm.skipped, ( size_t )80 * tm.tile_rows * tm.tile_columns );
+    CU_ASSERT_TRUE( tm.skipped > tm.computed );
+    free_tile_map( &tm );
+    free_bitboard( &full );
+    free_bitboard( &tiled );
+    free( b );
+}
+
+// Test 13: update_next_generation_sparse
+static void test_update_next_generation_sparse( void )
+{
+    // Test case 1: universe is NULL
+    SparseUniverse su;
+    CU_ASSERT_EQUAL( update_next_generation_sparse( NULL ), EXIT_FAILURE );
+    CU_ASSERT_EQUAL( load_sparse_from_board( &su, NULL ), EXIT_FAILURE );
+    // Test case 2: a soup in the middle of the board follows count_neighbors across the chunk borders
+    Board *b = tool_create_random_board( 200, 200, 11 );
+    Board *out = tool_create_random_board( 200, 200, 12 );
+    for ( int i = 0; i < b->rows; i++ )
+        for ( int j = 0; j < b->columns; j++ )
+            if ( i < 54 || i >= 74 || j < 54 || j >= 74 )
+                b->grid[i][j] = 0;
+    CU_ASSERT_EQUAL( load_sparse_from_board( &su, b ), EXIT_SUCCESS );
+    int same = TRUE;
+    for ( int gen = 0; gen < 50; gen++ )
+    {
+        update_next_generation_sparse( &su );
+        tool_step_reference( b );
+    }
+    store_sparse_to_board( &su, out );
+    for ( int i = 0; i < b->rows; i++ )
+        if ( memcmp( out->grid[i], b->grid[i], b->columns ) != 0 )
+            same = FALSE;
+    CU_ASSERT_TRUE( same );
+    free_sparse_universe( &su );
+    free( b );
+    free( out );
+    // Test case 3: a glider far from the origin flies on, and the chunks it leaves are freed
+    const int64_t x = -1000000000000LL, y = 5000000000LL;
+    CU_ASSERT_EQUAL( init_sparse_universe( &su ), EXIT_SUCCESS );
+    set_sparse_cell( &su, x + 1, y, 1 );
+    set_sparse_cell( &su, x + 2, y + 1, 1 );
+    set_sparse_cell( &su, x, y + 2, 1 );
+    set_sparse_cell( &su, x + 1, y + 2, 1 );
+    set_sparse_cell( &su, x + 2, y + 2, 1 );
+    for ( int gen = 0; gen < 4 * 300; gen++ )
+        update_next_generation_sparse( &su );
+    CU_ASSERT_EQUAL( su.population, 5 );
+    CU_ASSERT_TRUE( su.chunk_count <= 4 );
+    CU_ASSERT_EQUAL( su.min_x, x + 300 );
+    CU_ASSERT_EQUAL( su.min_y, y + 300 );
+    CU_ASSERT_EQUAL( su.max_x, x + 302 );
+    CU_ASSERT_EQUAL( su.max_y, y + 302 );
+    CU_ASSERT_EQUAL( get_sparse_cell( &su, x + 301, y + 300 ), 1 );
+    CU_ASSERT_EQUAL( get_sparse_cell( &su, x + 300, y + 300 ), 0 );
+    free_sparse_universe( &su );
+    // Test case 4: more chunks than the 1024 buckets of a new map, a blinker in each one and a lone cell in as many that die
+    CU_ASSERT_EQUAL( init_sparse_universe( &su ), EXIT_SUCCESS );
+    for ( int i = 0; i < 1500; i++ )
+    {
+        int64_t cx = ( int64_t )( i % 50 ) * 128 + 30, cy = ( int64_t )( i / 50 ) * 64 + 30;
+        set_sparse_cell( &su, cx, cy, 1 );
+        set_sparse_cell( &su, cx + 1, cy, 1 );
+        set_sparse_cell( &su, cx + 2, cy, 1 );
+        set_sparse_cell( &su, cx + 64, cy, 1 );
+    }
+    CU_ASSERT_TRUE( su.chunk_count > 2048 );
+    for ( int gen = 0; gen < 3; gen++ )
+        CU_ASSERT_EQUAL( update_next_generation_sparse( &su ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( su.population, 3 * 1500 );
+    CU_ASSERT_EQUAL( su.chunk_count, 1500 );
+    same = TRUE;
+    for ( int i = 0; i < 1500; i++ )
+    {
+        int64_t cx = ( int64_t )( i % 50 ) * 128 + 31, cy = ( int64_t )( i / 50 ) * 64 + 30;
+        if ( !get_sparse_cell( &su, cx, cy - 1 ) || !get_sparse_cell( &su, cx, cy + 1 ) || get_sparse_cell( &su, cx + 63, cy ) )
+            same = FALSE;
+    }
+    CU_ASSERT_TRUE( same );
+    free_sparse_universe( &su );
+}
+
+// Test 14: update_next_generation_tracked
+static void test_update_next_generation_tracked( void )
+{
+    // Test case 1: a change set needs a board size
+    ChangeSet cs;
+    CU_ASSERT_EQUAL( init_change_set( &cs, 0, 10 ), EXIT_FAILURE );
+    // Test case 2: a glider only changes the tiles it is in
+    Board b;
+    b.rows = 100;
+    b.columns = 130;
+    b.rule = RULE_CONWAY;
+    b.boundary = BOUNDARY_DEAD;
+    CU_ASSERT_EQUAL( init_board_by_user( &b ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( init_change_set( &cs, b.rows, b.columns ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( cs.tile_rows, 4 );
+    CU_ASSERT_EQUAL( cs.tile_columns, 5 );
+    b.grid[40][71] = b.grid[41][72] = b.grid[42][70] = b.grid[42][71] = b.grid[42][72] = 1;
+    CU_ASSERT_EQUAL( update_next_generation_tracked( &b, &cs ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( cs.count, 1 );
+    CU_ASSERT_EQUAL( cs.tiles[0], 1 * cs.tile_columns + 2 );
+    // Test case 3: a tile is listed once however many of its cells change, until the set is cleared
+    mark_cell_changed( &cs, 33, 65 );
+    mark_cell_changed( &cs, 0, 129 );
+    mark_cell_changed( &cs, 1, 128 );
+    CU_ASSERT_EQUAL( cs.count, 2 );
+    clear_change_set( &cs );
+    CU_ASSERT_EQUAL( cs.count, 0 );
+    mark_cell_changed( &cs, 40, 70 );
+    CU_ASSERT_EQUAL( cs.count, 1 );
+    clear_change_set( &cs );
+    // Test case 4: a still life changes nothing
+    clear_all_cells( &b );
+    b.grid[10][10] = b.grid[10][11] = b.grid[11][10] = b.grid[11][11] = 1;
+    CU_ASSERT_EQUAL( update_next_generation_tracked( &b, &cs ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( cs.count, 0 );
+    free_change_set( &cs );
+    free_board( &b );
+}
+
+// Test 15: the simulation thread
+static void test_simulation( void )
+{
+    // Test case 1: the first snapshot is the board itself, paused at generation 0
+    Simulation sim;
+    Snapshot latest;
+    Board *b = tool_create_random_board( 60, 70, 21 );
+    Board *shown = tool_create_random_board( 60, 70, 22 );
+    b->delay = 0;
+    CU_ASSERT_EQUAL( start_simulation( &sim, b, ENGINE_BITBOARD ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( receive_snapshot( &sim, shown, NULL, &latest ), 1 );
+    CU_ASSERT_EQUAL( latest.generation, 0 );
+    CU_ASSERT_TRUE( latest.paused );
+    int same = TRUE;
+    for ( int i = 0; i < b->rows; i++ )
+        if ( memcmp( shown->grid[i], b->grid[i], b->columns ) != 0 )
+            same = FALSE;
+    CU_ASSERT_TRUE( same );
+    // Test case 2: the thread runs to the limit and pauses there, following count_neighbors
+    CU_ASSERT_EQUAL( send_simulation_command( &sim, SIM_SET_LIMIT, 0, 0, 10 ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( send_simulation_command( &sim, SIM_RESUME, 0, 0, 0 ), EXIT_SUCCESS );
+    time_t deadline = time( NULL ) + 10;
+    latest.paused = FALSE;
+    while ( !( latest.generation == 10 && latest.paused ) && time( NULL ) < deadline )
+        receive_snapshot( &sim, shown, NULL, &latest );
+    CU_ASSERT_EQUAL( latest.generation, 10 );
+    for ( int gen = 0; gen < 10; gen++ )
+        tool_step_reference( b );
+    same = TRUE;
+    for ( int i = 0; i < b->rows; i++ )
+        if ( memcmp( shown->grid[i], b->grid[i], b->columns ) != 0 )
+            same = FALSE;
+    CU_ASSERT_TRUE( same );
+    // Test case 3: an edit sent while paused is in the next snapshot, only its tile is marked
+    ChangeSet cs;
+    CU_ASSERT_EQUAL( init_change_set( &cs, shown->rows, shown->columns ), EXIT_SUCCESS );
+    int cell = !shown->grid[45][50];
+    CU_ASSERT_EQUAL( send_simulation_command( &sim, SIM_SET_CELL, 45, 50, cell ), EXIT_SUCCESS );
+    deadline = time( NULL ) + 10;
+    while ( !receive_snapshot( &sim, shown, &cs, &latest ) && time( NULL ) < deadline );
+    CU_ASSERT_EQUAL( shown->grid[45][50], cell );
+    CU_ASSERT_EQUAL( latest.generation, 10 );
+    CU_ASSERT_EQUAL( cs.count, 1 );
+    CU_ASSERT_EQUAL( cs.tiles[0], 1 * cs.tile_columns + 1 );
+    // Test case 4: clearing the board starts again from generation 0
+    CU_ASSERT_EQUAL( send_simulation_command( &sim, SIM_CLEAR, 0, 0, 0 ), EXIT_SUCCESS );
+    deadline = time( NULL ) + 10;
+    while ( !receive_snapshot( &sim, shown, NULL, &latest ) && time( NULL ) < deadline );
+    CU_ASSERT_EQUAL( latest.generation, 0 );
+    CU_ASSERT_EQUAL( shown->grid[45][50], 0 );
+    stop_simulation( &sim );
+    free_change_set( &cs );
+    free( b );
+    free( shown );
+    // Test case 5: an edit is written into every engine as it is, and the next generations follow count_neighbors
+    for ( int type = 0; type < ENGINE_COUNT; type++ )
+    {
+        Board *r = tool_create_random_board( 40, 90, 47 );
+        Board copy = *r;
+        CU_ASSERT_EQUAL( alloc_board( &copy ), EXIT_SUCCESS );
+        for ( int i = 0; i < r->rows; i++ )
+            memcpy( copy.grid[i], r->grid[i], r->columns );
+        Engine engine;
+        CU_ASSERT_EQUAL( init_engine( &engine, type, 1, &copy ), EXIT_SUCCESS );
+        CU_ASSERT_EQUAL( step_engine( &engine, 1 ), EXIT_SUCCESS );
+        tool_step_reference( r );
+        int code = set_engine_cell( &engine, 20, 70, !r->grid[20][70] );
+        CU_ASSERT_EQUAL( code, type == ENGINE_HASHLIFE ? EXIT_FAILURE : EXIT_SUCCESS );
+        CU_ASSERT_EQUAL( set_engine_cell( &engine, 40, 0, 1 ), EXIT_FAILURE );
+        if ( code == EXIT_SUCCESS )
+        {
+            r->grid[20][70] = !r->grid[20][70];
+            CU_ASSERT_EQUAL( store_engine_to_board( &engine ), EXIT_SUCCESS );
+            CU_ASSERT_EQUAL( copy.grid[20][70], r->grid[20][70] );
+        }
+        // The sparse universe has no edges, so it only follows count_neighbors away from them
+        if ( code == EXIT_SUCCESS && type != ENGINE_SPARSE )
+        {
+            CU_ASSERT_EQUAL( step_engine( &engine, 3 ), EXIT_SUCCESS );
+            CU_ASSERT_EQUAL( store_engine_to_board( &engine ), EXIT_SUCCESS );
+            for ( int gen = 0; gen < 3; gen++ )
+                tool_step_reference( r );
+            same = TRUE;
+            for ( int i = 0; i < r->rows; i++ )
+                if ( memcmp( copy.grid[i], r->grid[i], r->columns ) != 0 )
+                    same = FALSE;
+            CU_ASSERT_TRUE( same );
+        }
+        free_engine( &engine );
+        free_board( &copy );
+        free( r );
+    }
+    // Test case 6: only the tile of a blinker is listed in each generation, by the reference engine and a written back one
+    EngineType types[] = { ENGINE_REFERENCE, ENGINE_BITBOARD };
+    for ( int t = 0; t < 2; t++ )
+    {
+        b = ( Board* )calloc( 1, sizeof( Board ) );
+        shown = ( Board* )calloc( 1, sizeof( Board ) );
+        b->rule = shown->rule = RULE_CONWAY;
+        b->rows = shown->rows = 100;
+        b->columns = shown->columns = 100;
+        b->delay = 0;
+        CU_ASSERT_EQUAL( alloc_board( b ), EXIT_SUCCESS );
+        CU_ASSERT_EQUAL( alloc_board( shown ), EXIT_SUCCESS );
+        b->grid[70][40] = b->grid[70][41] = b->grid[70][42] = 1;
+        CU_ASSERT_EQUAL( init_change_set( &cs, b->rows, b->columns ), EXIT_SUCCESS );
+        CU_ASSERT_EQUAL( start_simulation( &sim, b, types[t] ), EXIT_SUCCESS );
+        CU_ASSERT_EQUAL( receive_snapshot( &sim, shown, &cs, &latest ), 1 );
+        CU_ASSERT_TRUE( cs.all );
+        clear_change_set( &cs );
+        CU_ASSERT_EQUAL( send_simulation_command( &sim, SIM_SET_LIMIT, 0, 0, 7 ), EXIT_SUCCESS );
+        CU_ASSERT_EQUAL( send_simulation_command( &sim, SIM_RESUME, 0, 0, 0 ), EXIT_SUCCESS );
+        deadline = time( NULL ) + 10;
+        int listed = TRUE;
+        latest.paused = FALSE;
+        while ( !( latest.generation == 7 && latest.paused ) && time( NULL ) < deadline )
+        {
+            if ( receive_snapshot( &sim, shown, &cs, &latest ) &&
+                ( cs.all || cs.count > 1 || ( cs.count == 1 && cs.tiles[0] != 2 * cs.tile_columns + 1 ) ) )
+                listed = FALSE;
+            clear_change_set( &cs );
+        }
+        CU_ASSERT_TRUE( listed );
+        CU_ASSERT_EQUAL( latest.generation, 7 );
+        // After an odd number of generations the blinker stands upright
+        CU_ASSERT_TRUE( shown->grid[69][41] && shown->grid[70][41] && shown->grid[71][41] );
+        CU_ASSERT_TRUE( !shown->grid[70][40] && !shown->grid[70][42] );
+        stop_simulation( &sim );
+        free_change_set( &cs );
+        free_board( b );
+        free_board( shown );
+        free( b );
+        free( shown );
+    }
+}
+
+// Test 16: turbo mode of the simulation thread
+static void test_simulation_turbo( void )
+{
+    // Test case 1: an unlimited rate runs to the limit in batches and follows count_neighbors
+    Simulation sim;
+    Snapshot latest;
+    Board *b = tool_create_random_board( 60, 70, 23 );
+    Board *shown = tool_create_random_board( 60, 70, 24 );
+    b->delay = MAX_DELAY;
+    CU_ASSERT_EQUAL( start_simulation( &sim, b, ENGINE_BITBOARD ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( send_simulation_command( &sim, SIM_SET_LIMIT, 0, 0, 2000 ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( send_simulation_command( &sim, SIM_SET_RATE, 0, 0, SIM_RATE_UNLIMITED ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( send_simulation_command( &sim, SIM_RESUME, 0, 0, 0 ), EXIT_SUCCESS );
+    time_t deadline = time( NULL ) + 10;
+    latest.generation = 0;
+    latest.paused = FALSE;
+    int snapshots = 0;
+    while ( !( latest.generation == 2000 && latest.paused ) && time( NULL ) < deadline )
+        snapshots += receive_snapshot( &sim, shown, NULL, &latest );
+    // The delay of a second would take half an hour for these generations
+    CU_ASSERT_EQUAL( latest.generation, 2000 );
+    CU_ASSERT_TRUE( snapshots < 2000 );
+    for ( int gen = 0; gen < 2000; gen++ )
+        tool_step_reference( b );
+    int same = TRUE;
+    for ( int i = 0; i < b->rows; i++ )
+        if ( memcmp( shown->grid[i], b->grid[i], b->columns ) != 0 )
+            same = FALSE;
+    CU_ASSERT_TRUE( same );
+    // Test case 2: a target rate is kept to, and the achieved rate is reported
+    CU_ASSERT_EQUAL( send_simulation_command( &sim, SIM_SET_LIMIT, 0, 0, 0 ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( send_simulation_command( &sim, SIM_SET_RATE, 0, 0, 1000 ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( send_simulation_command( &sim, SIM_RESUME, 0, 0, 0 ), EXIT_SUCCESS );
+    deadline = time( NULL ) + 10;
+    time_t start = time( NULL );
+    while ( latest.generation < 3200 && time( NULL ) < deadline )
+        receive_snapshot( &sim, shown, NULL, &latest );
+    CU_ASSERT_TRUE( time( NULL ) - start >= 1 );
+    CU_ASSERT_TRUE( latest.rate > 500 && latest.rate < 1500 );
+    stop_simulation( &sim );
+    free( b );
+    free( shown );
+}
+
+// Test 17: binary snapshot files
+static void test_bin_file( void )
+{
+    // Test case 1: only names with the snapshot extension are snapshots
+    CU_ASSERT_TRUE( is_bin_file( "board.bin" ) );
+    CU_ASSERT_TRUE( !is_bin_file( "data.txt" ) );
+    CU_ASSERT_TRUE( !is_bin_file( ".bin" ) );
+    CU_ASSERT_TRUE( !is_bin_file( NULL ) );
+    // Test case 2: a board is saved and loaded with its size, delay and generation
+    Board *b = tool_create_random_board( 77, 131, 25 );
+    b->delay = 60;
+    CU_ASSERT_EQUAL( write_board_to_bin( "test_snapshot.bin", b, 1234 ), EXIT_SUCCESS );
+    Board loaded;
+    uint64_t generation = 0;
+    memset( &loaded, 0, sizeof( Board ) );
+    CU_ASSERT_EQUAL( load_board_from_bin( "test_snapshot.bin", &loaded, &generation ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( loaded.rows, 77 );
+    CU_ASSERT_EQUAL( loaded.columns, 131 );
+    CU_ASSERT_EQUAL( loaded.delay, 60 );
+    CU_ASSERT_EQUAL( generation, 1234 );
+    int same = TRUE;
+    for ( int i = 0; i < b->rows; i++ )
+        if ( memcmp( loaded.grid[i], b->grid[i], b->columns ) != 0 )
+            same = FALSE;
+    CU_ASSERT_TRUE( same );
+    // Test case 3: the cells start after the padded header and are the words of the bit-packed board
+    BinFile bin;
+    BitBoard bb, bits;
+    CU_ASSERT_EQUAL( load_bitboard_from_board( &bb, b ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( open_bin_file( "test_snapshot.bin", &bin ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( ( char* )bin.words - ( char* )bin.mapping, BIN_HEADER_SIZE );
+    CU_ASSERT_EQUAL( bin.header->rule, BIN_RULE_CONWAY );
+    CU_ASSERT_EQUAL( memcmp( bin.words, bb.cells, bin.header->data_size ), 0 );
+    close_bin_file( &bin );
+    // Test case 4: a bit-packed board is written as it is and loaded back
+    CU_ASSERT_EQUAL( write_bitboard_to_bin( "test_snapshot.bin", &bb, 60, 99 ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( load_bitboard_from_bin( "test_snapshot.bin", &bits, &generation ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( generation, 99 );
+    CU_ASSERT_EQUAL( memcmp( bits.cells, bb.cells, ( size_t )bb.rows * bb.words_per_row * sizeof( uint64_t ) ), 0 );
+    free_bitboard( &bits );
+    // Test case 5: a corrupted cell is found by the checksum
+    FILE *fp = fopen( "test_snapshot.bin", "r+b" );
+    fseek( fp, BIN_HEADER_SIZE + 100, SEEK_SET );
+    fputc( 0x5a, fp );
+    fclose( fp );
+    CU_ASSERT_EQUAL( open_bin_file( "test_snapshot.bin", &bin ), EXIT_FAILURE );
+    CU_ASSERT_EQUAL( load_bitboard_from_bin( "test_snapshot.bin", &bits, NULL ), EXIT_FAILURE );
+    // Test case 6: a text file or a missing file is not a snapshot
+    fp = fopen( "test_snapshot.bin", "w" );
+    fprintf( fp, "0 1 0\n" );
+    fclose( fp );
+    CU_ASSERT_EQUAL( open_bin_file( "test_snapshot.bin", &bin ), EXIT_FAILURE );
+    remove( "test_snapshot.bin" );
+    CU_ASSERT_EQUAL( open_bin_file( "test_snapshot.bin", &bin ), EXIT_FAILURE );
+    // Test case 7: a version 1 file, with a 4 KiB header and the reserved boundary field, is loaded with dead edges
+    CU_ASSERT_EQUAL( write_bitboard_to_bin( "test_snapshot.bin", &bb, 60, 7 ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( open_bin_file( "test_snapshot.bin", &bin ), EXIT_SUCCESS );
+    BinHeader old = *bin.header;
+    size_t data_size = ( size_t )old.data_size;
+    uint64_t *words = malloc( data_size );
+    memcpy( words, bin.words, data_size );
+    close_bin_file( &bin );
+    old.version = 1;
+    old.header_size = BIN_V1_HEADER_SIZE;
+    old.boundary = 0;
+    static const char padding[BIN_V1_HEADER_SIZE];
+    fp = fopen( "test_snapshot.bin", "wb" );
+    fwrite( &old, sizeof( BinHeader ), 1, fp );
+    fwrite( padding, BIN_V1_HEADER_SIZE - sizeof( BinHeader ), 1, fp );
+    fwrite( words, data_size, 1, fp );
+    fclose( fp );
+    free_board( &loaded );
+    memset( &loaded, 0, sizeof( Board ) );
+    loaded.boundary = BOUNDARY_TORUS;
+    CU_ASSERT_EQUAL( load_board_from_bin( "test_snapshot.bin", &loaded, &generation ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( generation, 7 );
+    CU_ASSERT_EQUAL( loaded.boundary, BOUNDARY_DEAD );
+    same = TRUE;
+    for ( int i = 0; i < b->rows; i++ )
+        if ( memcmp( loaded.grid[i], b->grid[i], b->columns ) != 0 )
+            same = FALSE;
+    CU_ASSERT_TRUE( same );
+    // Test case 8: a version 1 header size is refused in a version 2 file
+    old.version = BIN_VERSION;
+    fp = fopen( "test_snapshot.bin", "r+b" );
+    fwrite( &old, sizeof( BinHeader ), 1, fp );
+    fclose( fp );
+    CU_ASSERT_EQUAL( open_bin_file( "test_snapshot.bin", &bin ), EXIT_FAILURE );
+    remove( "test_snapshot.bin" );
+    free( words );
+    free_bitboard( &bb );
+    free_board( &loaded );
+    free( b );
+}
+
+// Test 18: RLE and Life 1.06 pattern files
+static void test_pattern_file( void )
+{
+    // Test case 1: the format is taken from the extension
+    CU_ASSERT_EQUAL( get_pattern_format( "gun.rle" ), PATTERN_RLE );
+    CU_ASSERT_EQUAL( get_pattern_format( "gun.lif" ), PATTERN_LIFE106 );
+    CU_ASSERT_EQUAL( get_pattern_format( "data.txt" ), PATTERN_NONE );
+    // Test case 2: an RLE glider is placed at an offset, over the cells already in the board
+    Board b;
+    PatternInfo info;
+    memset( &b, 0, sizeof( Board ) );
+    b.rows = 20;
+    b.columns = 30;
+    CU_ASSERT_EQUAL( alloc_board( &b ), EXIT_SUCCESS );
+    b.grid[0][0] = 1;
+    FILE *fp = fopen( "test_pattern.rle", "w" );
+    fprintf( fp, "#N Glider\nx = 3, y = 3, rule = B3/S23\nbo$2b\no$3o!\nanything after the end\n" );
+    fclose( fp );
+    CU_ASSERT_EQUAL( read_pattern_file( "test_pattern.rle", &b, 5, 7, &info ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( info.format, PATTERN_RLE );
+    CU_ASSERT_EQUAL( info.width, 3 );
+    CU_ASSERT_EQUAL( info.height, 3 );
+    CU_ASSERT_EQUAL( info.cells, 5 );
+    CU_ASSERT_EQUAL( b.grid[0][0], 1 );
+    CU_ASSERT_EQUAL( b.grid[5][8], 1 );
+    CU_ASSERT_EQUAL( b.grid[6][9], 1 );
+    CU_ASSERT_TRUE( b.grid[7][7] && b.grid[7][8] && b.grid[7][9] );
+    CU_ASSERT_EQUAL( b.grid[5][7], 0 );
+    // Test case 3: cells outside the board are clipped, runs longer than a block are read across blocks
+    clear_all_cells( &b );
+    fp = fopen( "test_pattern.rle", "w" );
+    fprintf( fp, "x = 40, y = 2\n" );
+    for ( int i = 0; i < PATTERN_BLOCK_SIZE; i++ )
+        fputc( i % 2 == 0 ? ' ' : '\n', fp );
+    fprintf( fp, "40o$1\n2b3o!" );
+    fclose( fp );
+    CU_ASSERT_EQUAL( read_pattern_file( "test_pattern.rle", &b, 19, -2, &info ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( info.cells, 30 );
+    CU_ASSERT_EQUAL( info.clipped, 10 + 3 );
+    CU_ASSERT_EQUAL( b.grid[19][0], 1 );
+    CU_ASSERT_EQUAL( b.grid[19][29], 1 );
+    // Test case 4: a board written as RLE is read back in the same place
+    Board *r = tool_create_random_board( 20, 30, 26 );
+    r->grid[0][0] = r->grid[0][1] = 0;
+    for ( int j = 0; j < r->columns; j++ )
+        r->grid[3][j] = r->grid[4][j] = 0;
+    CU_ASSERT_EQUAL( write_pattern_file( "test_pattern.rle", r ), EXIT_SUCCESS );
+    clear_all_cells( &b );
+    CU_ASSERT_EQUAL( read_pattern_file( "test_pattern.rle", &b, 0, 0, NULL ), EXIT_SUCCESS );
+    int same = TRUE;
+    for ( int i = 0; i < r->rows; i++ )
+        if ( memcmp( b.grid[i], r->grid[i], r->columns ) != 0 )
+            same = FALSE;
+    CU_ASSERT_TRUE( same );
+    // Test case 5: the same board is read back from Life 1.06
+    CU_ASSERT_EQUAL( write_pattern_file( "test_pattern.lif", r ), EXIT_SUCCESS );
+    clear_all_cells( &b );
+    CU_ASSERT_EQUAL( read_pattern_file( "test_pattern.lif", &b, 0, 0, &info ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( info.format, PATTERN_LIFE106 );
+    same = TRUE;
+    for ( int i = 0; i < r->rows; i++ )
+        if ( memcmp( b.grid[i], r->grid[i], r->columns ) != 0 )
+            same = FALSE;
+    CU_ASSERT_TRUE( same );
+    // Test case 6: Life 1.06 coordinates can be negative, a malformed line is an error
+    clear_all_cells( &b );
+    fp = fopen( "test_pattern.lif", "w" );
+    fprintf( fp, "#Life 1.06\n-1 -1\n0 -1\n 1 0\n-2 1" );
+    fclose( fp );
+    CU_ASSERT_EQUAL( read_pattern_file( "test_pattern.lif", &b, 10, 10, &info ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( info.cells, 4 );
+    CU_ASSERT_TRUE( b.grid[9][9] && b.grid[9][10] && b.grid[10][11] && b.grid[11][8] );
+    fp = fopen( "test_pattern.lif", "w" );
+    fprintf( fp, "#Life 1.06\n1 2\n3\n" );
+    fclose( fp );
+    CU_ASSERT_EQUAL( read_pattern_file( "test_pattern.lif", &b, 0, 0, NULL ), EXIT_FAILURE );
+    fp = fopen( "test_pattern.rle", "w" );
+    fprintf( fp, "x = 3, y = 3\nbo$2b%%o!\n" );
+    fclose( fp );
+    CU_ASSERT_EQUAL( read_pattern_file( "test_pattern.rle", &b, 0, 0, NULL ), EXIT_FAILURE );
+    // Test case 7: a missing file can not be read
+    remove( "test_pattern.rle" );
+    remove( "test_pattern.lif" );
+    CU_ASSERT_EQUAL( read_pattern_file( "test_pattern.rle", &b, 0, 0, NULL ), EXIT_FAILURE );
+    free_board( &b );
+    free( r );
+}
+
+// Test 19: read_data_file
+static void test_read_data_file( void )
+{
+    // Test case 1: a written board is read back by one thread and by several threads
+    Board *r = tool_create_random_board( 300, 257, 27 );
+    CU_ASSERT_EQUAL( write_data_file( "test_data.txt", r ), EXIT_SUCCESS );
+    for ( int threads = 1; threads <= 4; threads += 3 )
+    {
+        Board b;
+        memset( &b, 0, sizeof( Board ) );
+        b.rows = 300;
+        b.columns = 257;
+        CU_ASSERT_EQUAL( read_data_file( "test_data.txt", &b, threads ), EXIT_SUCCESS );
+        int same = TRUE;
+        for ( int i = 0; i < r->rows; i++ )
+            if ( memcmp( b.grid[i], r->grid[i], r->columns ) != 0 )
+                same = FALSE;
+        CU_ASSERT_TRUE( same );
+        // Test case 2: a board of another size is a changed configuration, the board is not kept
+        free_board( &b );
+        b.rows = 299;
+        CU_ASSERT_EQUAL( read_data_file( "test_data.txt", &b, threads ), 2 );
+        CU_ASSERT_TRUE( b.grid == NULL );
+        b.rows = 301;
+        CU_ASSERT_EQUAL( read_data_file( "test_data.txt", &b, threads ), 2 );
+        b.rows = 300;
+        b.columns = 258;
+        CU_ASSERT_EQUAL( read_data_file( "test_data.txt", &b, threads ), 2 );
+    }
+    // Test case 3: a cell that is not 0 or 1 is an error, so is a missing file
+    Board b;
+    memset( &b, 0, sizeof( Board ) );
+    b.rows = 2;
+    b.columns = 3;
+    FILE *fp = fopen( "test_data.txt", "w" );
+    fprintf( fp, "0 1 0 \n1 10 1 \n" );
+    fclose( fp );
+    CU_ASSERT_EQUAL( read_data_file( "test_data.txt", &b, 1 ), EXIT_FAILURE );
+    fp = fopen( "test_data.txt", "w" );
+    fprintf( fp, "0 1 0\r\n1 0 1" );
+    fclose( fp );
+    CU_ASSERT_EQUAL( read_data_file( "test_data.txt", &b, 1 ), EXIT_SUCCESS );
+    CU_ASSERT_TRUE( b.grid[1][0] && !b.grid[1][1] && b.grid[1][2] );
+    free_board( &b );
+    remove( "test_data.txt" );
+    CU_ASSERT_EQUAL( read_data_file( "test_data.txt", &b, 1 ), EXIT_FAILURE );
+    free( r );
+}
+
+// Test 20: the autosave
+static void test_autosave( void )
+{
+    // Test case 1: a text board is saved with its configuration and no temporary file is left
+    Board *r = tool_create_random_board( 40, 50, 28 );
+    r->delay = 120;
+    CU_ASSERT_EQUAL( save_board_file( "test_autosave.config", "test_autosave.txt", r, 0 ), EXIT_SUCCESS );
+    Board b;
+    memset( &b, 0, sizeof( Board ) );
+    CU_ASSERT_EQUAL( read_config_file( "test_autosave.config", &b ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( b.rows, 40 );
+    CU_ASSERT_EQUAL( b.columns, 50 );
+    CU_ASSERT_EQUAL( b.delay, 120 );
+    CU_ASSERT_EQUAL( read_data_file( "test_autosave.txt", &b, 1 ), EXIT_SUCCESS );
+    int same = TRUE;
+    for ( int i = 0; i < r->rows; i++ )
+        if ( memcmp( b.grid[i], r->grid[i], r->columns ) != 0 )
+            same = FALSE;
+    CU_ASSERT_TRUE( same );
+    free_board( &b );
+    FILE *fp = fopen( "test_autosave.txt" AUTOSAVE_SUFFIX, "r" );
+    CU_ASSERT_PTR_NULL( fp );
+    if ( fp != NULL )
+        fclose( fp );
+    // Test case 2: the writer thread saves a copy, the board can change while it is written
+    AutoSave autosave;
+    CU_ASSERT_EQUAL( start_autosave( &autosave, NULL, "test_autosave.bin", r ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( request_autosave( &autosave, r, 77 ), EXIT_SUCCESS );
+    Cell first = r->grid[0][0];
+    r->grid[0][0] = !first;
+    stop_autosave( &autosave );
+    CU_ASSERT_EQUAL( autosave.saves, 1 );
+    CU_ASSERT_EQUAL( autosave.failures, 0 );
+    uint64_t generation = 0;
+    CU_ASSERT_EQUAL( load_board_from_bin( "test_autosave.bin", &b, &generation ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( generation, 77 );
+    CU_ASSERT_EQUAL( b.grid[0][0], first );
+    CU_ASSERT_EQUAL( memcmp( b.grid[39], r->grid[39], r->columns ), 0 );
+    free_board( &b );
+    // Test case 3: a board of another size is not copied, stopping twice does nothing
+    Board *small = tool_create_random_board( 4, 5, 29 );
+    CU_ASSERT_EQUAL( start_autosave( &autosave, NULL, "test_autosave.bin", r ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( request_autosave( &autosave, small, 1 ), EXIT_FAILURE );
+    stop_autosave( &autosave );
+    stop_autosave( &autosave );
+    CU_ASSERT_EQUAL( autosave.saves, 0 );
+    // Test case 4: a failed save leaves the old file in place
+    CU_ASSERT_EQUAL( save_board_file( NULL, "missing_directory/test_autosave.bin", r, 0 ), EXIT_FAILURE );
+    CU_ASSERT_EQUAL( load_board_from_bin( "test_autosave.bin", &b, &generation ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( generation, 77 );
+    free_board( &b );
+    remove( "test_autosave.config" );
+    remove( "test_autosave.txt" );
+    remove( "test_autosave.bin" );
+    free( small );
+    free( r );
+}
+
+
+// Test 21: cycle and still life detection
+static void test_cycle_detector( void )
+{
+    // Test case 1: a blinker is a cycle of period 2 from the start, on every engine that gives its words
+    static CycleDetector cycle;
+    Board b;
+    memset( &b, 0, sizeof( Board ) );
+    b.rows = 12;
+    b.columns = 70;
+    b.rule = RULE_CONWAY;
+    CU_ASSERT_EQUAL( alloc_board( &b ), EXIT_SUCCESS );
+    EngineType types[] = { ENGINE_REFERENCE, ENGINE_BITBOARD, ENGINE_SIMD, ENGINE_TILED };
+    for ( int t = 0; t < 4; t++ )
+    {
+        clear_all_cells( &b );
+        b.grid[5][62] = b.grid[5][63] = b.grid[5][64] = 1;
+        Engine engine;
+        size_t count;
+        CU_ASSERT_EQUAL( init_engine( &engine, types[t], 1, &b ), EXIT_SUCCESS );
+        init_cycle_detector( &cycle, 10 );
+        const uint64_t *words = get_engine_words( &engine, &count );
+        CU_ASSERT_EQUAL( add_cycle_generation( &cycle, words, count ), 0 );
+        int generations = 0;
+        for ( ; generations < 10; generations++ )
+        {
+            step_engine( &engine, 1 );
+            words = get_engine_words( &engine, &count );
+            if ( add_cycle_generation( &cycle, words, count ) )
+                break;
+        }
+        CU_ASSERT_EQUAL( generations, 3 );
+        CU_ASSERT_EQUAL( cycle.period, 2 );
+        CU_ASSERT_EQUAL( cycle.first, 10 );
+        free_cycle_detector( &cycle );
+        free_engine( &engine );
+    }
+    // Test case 2: a glider runs into the corner and settles into a block at the first generation found
+    Engine engine;
+    size_t count;
+    clear_all_cells( &b );
+    b.grid[0][1] = b.grid[1][2] = b.grid[2][0] = b.grid[2][1] = b.grid[2][2] = 1;
+    CU_ASSERT_EQUAL( init_engine( &engine, ENGINE_BITBOARD, 1, &b ), EXIT_SUCCESS );
+    init_cycle_detector( &cycle, 0 );
+    const uint64_t *state = get_engine_words( &engine, &count );
+    add_cycle_generation( &cycle, state, count );
+    for ( int gen = 0; gen < 1000; gen++ )
+    {
+        step_engine( &engine, 1 );
+        state = get_engine_words( &engine, &count );
+        if ( add_cycle_generation( &cycle, state, count ) )
+            break;
+    }
+    free_engine( &engine );
+    CU_ASSERT_EQUAL( cycle.period, 1 );
+    CU_ASSERT_TRUE( cycle.first > 0 );
+    clear_all_cells( &b );
+    b.grid[0][1] = b.grid[1][2] = b.grid[2][0] = b.grid[2][1] = b.grid[2][2] = 1;
+    for ( uint64_t gen = 1; gen < cycle.first; gen++ )
+        update_next_generation( &b );
+    Board *r = tool_create_random_board( b.rows, b.columns, 30 );
+    int changed[2];
+    for ( int k = 0; k < 2; k++ )
+    {
+        for ( int i = 0; i < b.rows; i++ )
+            memcpy( r->grid[i], b.grid[i], b.columns );
+        update_next_generation( &b );
+        changed[k] = FALSE;
+        for ( int i = 0; i < b.rows; i++ )
+            if ( memcmp( b.grid[i], r->grid[i], b.columns ) != 0 )
+                changed[k] = TRUE;
+    }
+    CU_ASSERT_TRUE( changed[0] );
+    CU_ASSERT_FALSE( changed[1] );
+    free_cycle_detector( &cycle );
+    // Test case 3: a hash that matches a different state is not a cycle
+    uint64_t words[2] = { 1, 2 };
+    init_cycle_detector( &cycle, 0 );
+    for ( int i = 0; i < 3; i++ )
+    {
+        words[1] = 2 + i;
+        CU_ASSERT_EQUAL( add_cycle_generation( &cycle, words, 2 ), 0 );
+    }
+    cycle.hashes[2] = get_state_hash( ( uint64_t[2] ){ 1, 100 }, 2 );
+    cycle.buckets[cycle.hashes[2] & ( 2 * CYCLE_HISTORY - 1 )] = 2;
+    cycle.chain[2] = -1;
+    words[1] = 100;
+    CU_ASSERT_EQUAL( add_cycle_generation( &cycle, words, 2 ), 0 );
+    words[1] = 7;
+    CU_ASSERT_EQUAL( add_cycle_generation( &cycle, words, 2 ), 0 );
+    words[1] = 8;
+    CU_ASSERT_EQUAL( add_cycle_generation( &cycle, words, 2 ), 0 );
+    CU_ASSERT_EQUAL( cycle.collisions, 1 );
+    CU_ASSERT_FALSE( cycle.found );
+    // Test case 4: a period longer than the history is not found
+    free_cycle_detector( &cycle );
+    init_cycle_detector( &cycle, 0 );
+    int found = FALSE;
+    for ( int i = 0; i < 3 * CYCLE_HISTORY; i++ )
+    {
+        words[1] = i % ( CYCLE_HISTORY + 1 );
+        found = found || add_cycle_generation( &cycle, words, 2 );
+    }
+    CU_ASSERT_FALSE( found );
+    free_cycle_detector( &cycle );
+    free_board( &b );
+    free( r );
+}
+
+
+// Test 22: Life-like rules
+static void test_rules( void )
+{
+    // Test case 1: the notations and names give the same masks, B0 and malformed rules are refused
+    uint32_t rule;
+    char text[RULE_TEXT_LENGTH];
+    CU_ASSERT_EQUAL( parse_rule( "B3/S23", &rule ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( rule, RULE_CONWAY );
+    CU_ASSERT_EQUAL( parse_rule( "23/36", &rule ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( rule, RULE_HIGHLIFE );
+    CU_ASSERT_EQUAL( parse_rule( "s34678/b3678", &rule ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( rule, RULE_DAY_AND_NIGHT );
+    CU_ASSERT_EQUAL( parse_rule( "seeds", &rule ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( rule, RULE_SEEDS );
+    CU_ASSERT_STRING_EQUAL( format_rule( RULE_DAY_AND_NIGHT, text ), "B3678/S34678" );
+    CU_ASSERT_STRING_EQUAL( format_rule( RULE_SEEDS, text ), "B2/S" );
+    CU_ASSERT_EQUAL( parse_rule( "B03/S23", &rule ), EXIT_FAILURE );
+    CU_ASSERT_EQUAL( parse_rule( "B39/S23", &rule ), EXIT_FAILURE );
+    CU_ASSERT_EQUAL( parse_rule( "B3S23", &rule ), EXIT_FAILURE );
+    CU_ASSERT_EQUAL( get_next_state( RULE_HIGHLIFE, 0, 6 ), 1 );
+    CU_ASSERT_EQUAL( get_next_state( RULE_HIGHLIFE, 1, 6 ), 0 );
+    // Test case 2: every engine on a bounded board follows the reference step, for the specialised and generic kernels
+    uint32_t rules[] = { RULE_HIGHLIFE, RULE_DAY_AND_NIGHT, RULE_SEEDS, RULE_BIRTH( 3 ) | RULE_BIRTH( 5 ) | RULE_SURVIVE( 1 ) | RULE_SURVIVE( 8 ) };
+    EngineType types[] = { ENGINE_BITBOARD, ENGINE_PARALLEL, ENGINE_SIMD, ENGINE_TILED };
+    for ( int r = 0; r < 4; r++ )
+    {
+        Board *b = tool_create_random_board( 45, 140, 31 + r );
+        b->rule = rules[r];
+        Board expected = *b;
+        CU_ASSERT_EQUAL( alloc_board( &expected ), EXIT_SUCCESS );
+        for ( int i = 0; i < b->rows; i++ )
+            memcpy( expected.grid[i], b->grid[i], b->columns );
+        for ( int gen = 0; gen < 9; gen++ )
+            update_next_generation( &expected );
+        for ( int t = 0; t < 4; t++ )
+        {
+            Board copy = *b;
+            CU_ASSERT_EQUAL( alloc_board( &copy ), EXIT_SUCCESS );
+            for ( int i = 0; i < b->rows; i++ )
+                memcpy( copy.grid[i], b->grid[i], b->columns );
+            Engine engine;
+            CU_ASSERT_EQUAL( init_engine( &engine, types[t], types[t] == ENGINE_PARALLEL ? 3 : 1, &copy ), EXIT_SUCCESS );
+            CU_ASSERT_EQUAL( step_engine( &engine, 9 ), EXIT_SUCCESS );
+            CU_ASSERT_EQUAL( store_engine_to_board( &engine ), EXIT_SUCCESS );
+            int same = TRUE;
+            for ( int i = 0; i < b->rows; i++ )
+                if ( memcmp( copy.grid[i], expected.grid[i], b->columns ) != 0 )
+                    same = FALSE;
+            CU_ASSERT_TRUE( same );
+            free_engine( &engine );
+            free_board( &copy );
+        }
+        free_board( &expected );
+        free( b );
+    }
+    // Test case 3: the unbounded engines agree with each other away from the edges
+    Board *b = tool_create_random_board( 40, 40, 35 );
+    b->rule = RULE_HIGHLIFE;
+    for ( int i = 0; i < b->rows; i++ )
+        for ( int j = 0; j < b->columns; j++ )
+            if ( i < 15 || i >= 25 || j < 15 || j >= 25 )
+                b->grid[i][j] = 0;
+    Board other = *b;
+    CU_ASSERT_EQUAL( alloc_board( &other ), EXIT_SUCCESS );
+    for ( int i = 0; i < b->rows; i++ )
+        memcpy( other.grid[i], b->grid[i], b->columns );
+    Engine hashlife, sparse;
+    CU_ASSERT_EQUAL( init_engine( &hashlife, ENGINE_HASHLIFE, 1, b ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( init_engine( &sparse, ENGINE_SPARSE, 1, &other ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( step_engine( &hashlife, 8 ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( step_engine( &sparse, 8 ), EXIT_SUCCESS );
+    store_engine_to_board( &hashlife );
+    store_engine_to_board( &sparse );
+    int same = TRUE;
+    for ( int i = 0; i < b->rows; i++ )
+        if ( memcmp( b->grid[i], other.grid[i], b->columns ) != 0 )
+            same = FALSE;
+    CU_ASSERT_TRUE( same );
+    free_engine( &hashlife );
+    free_engine( &sparse );
+    // Test case 4: the rule is kept by the configuration file, the snapshots and the RLE files
+    Board loaded;
+    memset( &loaded, 0, sizeof( Board ) );
+    other.delay = 100;
+    CU_ASSERT_EQUAL( write_config_file( "test_rule.config", &other ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( read_config_file( "test_rule.config", &loaded ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( loaded.rule, RULE_HIGHLIFE );
+    other.rule = RULE_CONWAY;
+    CU_ASSERT_EQUAL( write_config_file( "test_rule.config", &other ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( read_config_file( "test_rule.config", &loaded ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( loaded.rule, RULE_CONWAY );
+    other.rule = RULE_DAY_AND_NIGHT;
+    uint64_t generation;
+    CU_ASSERT_EQUAL( write_board_to_bin( "test_rule.bin", &other, 3 ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( load_board_from_bin( "test_rule.bin", &loaded, &generation ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( loaded.rule, RULE_DAY_AND_NIGHT );
+    PatternInfo info;
+    CU_ASSERT_EQUAL( write_pattern_file( "test_rule.rle", &other ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( read_pattern_file( "test_rule.rle", &loaded, 0, 0, &info ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( info.rule, RULE_DAY_AND_NIGHT );
+    free_board( &loaded );
+    remove( "test_rule.config" );
+    remove( "test_rule.bin" );
+    remove( "test_rule.rle" );
+    free_board( &other );
+    free( b );
+}
+
+// Test 23: the lookup table engine
+static void test_update_next_generation_lookup( void )
+{
+    // Test case 1: the table of a blinker square, the middle column of three cells keeps its middle and grows a side
+    LookupTable table;
+    memset( &table, 0, sizeof( LookupTable ) );
+    CU_ASSERT_EQUAL( update_next_generation_lookup( NULL, &table ), EXIT_FAILURE );
+    CU_ASSERT_EQUAL( init_lookup_table( &table, RULE_CONWAY ), EXIT_SUCCESS );
+    unsigned blinker = ( 1u << 1 ) | ( 1u << 5 ) | ( 1u << 9 );
+    CU_ASSERT_EQUAL( table.next[blinker], 1 | 2 );
+    CU_ASSERT_EQUAL( table.next[0], 0 );
+    CU_ASSERT_EQUAL( table.next[LOOKUP_ENTRIES - 1], 0 );
+    free_lookup_table( &table );
+    // Test case 2: the engine follows the reference step, for odd sizes and rows that end inside a word or on one
+    int sizes[][2] = { { 1, 1 }, { 7, 63 }, { 33, 64 }, { 20, 65 }, { 41, 130 }, { 2, 200 } };
+    for ( int t = 0; t < 6; t++ )
+    {
+        Board *b = tool_create_random_board( sizes[t][0], sizes[t][1], 36 + t );
+        Board expected = *b;
+        CU_ASSERT_EQUAL( alloc_board( &expected ), EXIT_SUCCESS );
+        for ( int i = 0; i < b->rows; i++ )
+            memcpy( expected.grid[i], b->grid[i], b->columns );
+        for ( int gen = 0; gen < 25; gen++ )
+            update_next_generation( &expected );
+        Engine engine;
+        CU_ASSERT_EQUAL( init_engine( &engine, ENGINE_LOOKUP, 1, b ), EXIT_SUCCESS );
+        CU_ASSERT_EQUAL( step_engine( &engine, 25 ), EXIT_SUCCESS );
+        CU_ASSERT_EQUAL( store_engine_to_board( &engine ), EXIT_SUCCESS );
+        int same = TRUE;
+        for ( int i = 0; i < b->rows; i++ )
+            if ( memcmp( b->grid[i], expected.grid[i], b->columns ) != 0 )
+                same = FALSE;
+        CU_ASSERT_TRUE( same );
+        free_engine( &engine );
+        free_board( &expected );
+        free( b );
+    }
+    // Test case 3: the table is built again when the rule of the board changes
+    Board *b = tool_create_random_board( 50, 90, 42 );
+    Board expected = *b;
+    CU_ASSERT_EQUAL( alloc_board( &expected ), EXIT_SUCCESS );
+    for ( int i = 0; i < b->rows; i++ )
+        memcpy( expected.grid[i], b->grid[i], b->columns );
+    Engine engine;
+    CU_ASSERT_EQUAL( init_engine( &engine, ENGINE_LOOKUP, 1, b ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( step_engine( &engine, 3 ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( engine.lookup.builds, 1 );
+    for ( int gen = 0; gen < 3; gen++ )
+        update_next_generation( &expected );
+    engine.bits.rule = expected.rule = RULE_DAY_AND_NIGHT;
+    CU_ASSERT_EQUAL( step_engine( &engine, 6 ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( engine.lookup.builds, 2 );
+    CU_ASSERT_EQUAL( engine.lookup.rule, RULE_DAY_AND_NIGHT );
+    for ( int gen = 0; gen < 6; gen++ )
+        update_next_generation( &expected );
+    CU_ASSERT_EQUAL( store_engine_to_board( &engine ), EXIT_SUCCESS );
+    int same = TRUE;
+    for ( int i = 0; i < b->rows; i++ )
+        if ( memcmp( b->grid[i], expected.grid[i], b->columns ) != 0 )
+            same = FALSE;
+    CU_ASSERT_TRUE( same );
+    CU_ASSERT_STRING_EQUAL( get_engine_name( ENGINE_LOOKUP ), "lookup" );
+    CU_ASSERT_EQUAL( parse_engine_type( "lookup" ), ENGINE_LOOKUP );
+    free_engine( &engine );
+    free_board( &expected );
+    free( b );
+}
+
+// Test 24: boundary modes
+static void test_boundary_modes( void )
+{
+    // Test case 1: the names, and the neighbours of a single cell in the corner across each boundary
+    CU_ASSERT_EQUAL( parse_boundary_mode( "torus" ), BOUNDARY_TORUS );
+    CU_ASSERT_EQUAL( parse_boundary_mode( "klein" ), BOUNDARY_KLEIN );
+    CU_ASSERT_EQUAL( parse_boundary_mode( "sphere" ), -1 );
+    CU_ASSERT_STRING_EQUAL( get_boundary_name( BOUNDARY_DEAD ), "dead" );
+    Board b;
+    memset( &b, 0, sizeof( Board ) );
+    b.rows = 5;
+    b.columns = 6;
+    b.rule = RULE_CONWAY;
+    CU_ASSERT_EQUAL( alloc_board( &b ), EXIT_SUCCESS );
+    b.grid[0][0] = 1;
+    CU_ASSERT_EQUAL( count_neighbors( &b, 4, 5 ), 0 );
+    b.boundary = BOUNDARY_TORUS;
+    CU_ASSERT_EQUAL( count_neighbors( &b, 4, 5 ), 1 );
+    CU_ASSERT_EQUAL( count_neighbors( &b, 4, 1 ), 1 );
+    CU_ASSERT_EQUAL( count_neighbors( &b, 0, 5 ), 1 );
+    // Crossing the bottom edge of a Klein bottle mirrors the columns, crossing the sides does not
+    b.boundary = BOUNDARY_KLEIN;
+    CU_ASSERT_EQUAL( count_neighbors( &b, 4, 4 ), 1 );
+    CU_ASSERT_EQUAL( count_neighbors( &b, 4, 1 ), 0 );
+    CU_ASSERT_EQUAL( count_neighbors( &b, 0, 5 ), 1 );
+    free_board( &b );
+    // Test case 2: a glider on a torus comes back to where it started after crossing the whole board
+    Board glider;
+    memset( &glider, 0, sizeof( Board ) );
+    glider.rows = glider.columns = 20;
+    glider.rule = RULE_CONWAY;
+    glider.boundary = BOUNDARY_TORUS;
+    CU_ASSERT_EQUAL( alloc_board( &glider ), EXIT_SUCCESS );
+    glider.grid[17][18] = glider.grid[18][19] = glider.grid[19][17] = glider.grid[19][18] = glider.grid[19][19] = 1;
+    Board start = glider;
+    CU_ASSERT_EQUAL( alloc_board( &start ), EXIT_SUCCESS );
+    for ( int i = 0; i < glider.rows; i++ )
+        memcpy( start.grid[i], glider.grid[i], glider.columns );
+    for ( int gen = 0; gen < 80; gen++ )
+        update_next_generation( &glider );
+    int same = TRUE;
+    for ( int i = 0; i < glider.rows; i++ )
+        if ( memcmp( start.grid[i], glider.grid[i], glider.columns ) != 0 )
+            same = FALSE;
+    CU_ASSERT_TRUE( same );
+    free_board( &glider );
+    free_board( &start );
+    // Test case 3: the reference step and every vectorized kernel follow count_neighbors on both wrapped boundaries
+    BoundaryMode modes[] = { BOUNDARY_TORUS, BOUNDARY_KLEIN };
+    for ( int m = 0; m < 2; m++ )
+    {
+        for ( int k = SIMD_SCALAR; k <= detect_simd_kernel(); k++ )
+        {
+            CU_ASSERT_EQUAL( select_simd_kernel( k ), EXIT_SUCCESS );
+            Board *r = tool_create_random_board( 23, 45, 43 + m );
+            r->boundary = modes[m];
+            Board copy = *r;
+            CU_ASSERT_EQUAL( alloc_board( &copy ), EXIT_SUCCESS );
+            for ( int i = 0; i < r->rows; i++ )
+                memcpy( copy.grid[i], r->grid[i], r->columns );
+            Engine reference, simd;
+            CU_ASSERT_EQUAL( init_engine( &reference, ENGINE_REFERENCE, 1, &copy ), EXIT_SUCCESS );
+            CU_ASSERT_EQUAL( init_engine( &simd, ENGINE_SIMD, 1, &copy ), EXIT_SUCCESS );
+            same = TRUE;
+            for ( int gen = 0; gen < 30; gen++ )
+            {
+                tool_step_reference( r );
+                step_engine( &reference, 1 );
+                step_engine( &simd, 1 );
+                for ( int i = 0; i < r->rows; i++ )
+                    if ( memcmp( copy.grid[i], r->grid[i], r->columns ) != 0 ||
+                        memcmp( simd.simd.cells + i * simd.simd.stride, r->grid[i], r->columns ) != 0 )
+                        same = FALSE;
+            }
+            CU_ASSERT_TRUE( same );
+            free_engine( &reference );
+            free_engine( &simd );
+            free_board( &copy );
+            free( r );
+        }
+    }
+    select_simd_kernel( detect_simd_kernel() );
+    // Test case 4: the engines without a halo refuse to wrap, the boundary is kept by the configuration and the snapshots
+    Board *r = tool_create_random_board( 20, 30, 45 );
+    r->boundary = BOUNDARY_KLEIN;
+    r->delay = 100;
+    Board copy = *r;
+    CU_ASSERT_EQUAL( alloc_board( &copy ), EXIT_SUCCESS );
+    Engine engine;
+    CU_ASSERT_EQUAL( init_engine( &engine, ENGINE_BITBOARD, 1, &copy ), EXIT_FAILURE );
+    CU_ASSERT_EQUAL( init_engine( &engine, ENGINE_LOOKUP, 1, &copy ), EXIT_FAILURE );
+    Board loaded;
+    memset( &loaded, 0, sizeof( Board ) );
+    CU_ASSERT_EQUAL( write_config_file( "test_boundary.config", &copy ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( read_config_file( "test_boundary.config", &loaded ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( loaded.boundary, BOUNDARY_KLEIN );
+    CU_ASSERT_EQUAL( write_board_to_bin( "test_boundary.bin", &copy, 0 ), EXIT_SUCCESS );
+    loaded.boundary = BOUNDARY_DEAD;
+    CU_ASSERT_EQUAL( load_board_from_bin( "test_boundary.bin", &loaded, NULL ), EXIT_SUCCESS );
+    CU_ASSERT_EQUAL( loaded.boundary, BOUNDARY_KLEIN );
+    free_board( &loaded );
+    free_board( &copy );
+    remove( "test_boundary.config" );
+    remove( "test_boundary.bin" );
+    free( r );
+}
+
+// Test 25: the frame profiler
+static void test_frame_profiler( void )
+{
+    // Test case 1: the rolling minimum, average and 99th percentile of known frame times
+    FrameProfiler profiler;
+    CU_ASSERT_EQUAL( init_frame_profiler( &profiler, NULL ), EXIT_SUCCESS );
+    FrameStats stats;
+    get_frame_stats( &profiler, FRAME_TOTAL, &stats );
+    CU_ASSERT_DOUBLE_EQUAL( stats.p99, 0, 1e-9 );
+    double times[FRAME_PHASE_COUNT] = { 0 };
+    for ( int i = 1; i <= 100; i++ )
+    {
+        times[FRAME_PRESENT] = i;
+        times[FRAME_TOTAL] = i + 1;
+        add_frame_times( &profiler, times );
+    }
+    get_frame_stats( &profiler, FRAME_PRESENT, &stats );
+    CU_ASSERT_DOUBLE_EQUAL( stats.min, 1, 1e-9 );
+    CU_ASSERT_DOUBLE_EQUAL( stats.average, 50.5, 1e-9 );
+    CU_ASSERT_DOUBLE_EQUAL( stats.p99, 99, 1e-9 );
+    get_frame_stats( &profiler, FRAME_EVENTS, &stats );
+    CU_ASSERT_DOUBLE_EQUAL( stats.p99, 0, 1e-9 );
+    // Only the last FRAME_HISTORY frames count, the slow ones at the start are forgotten
+    times[FRAME_PRESENT] = 0.5;
+    for ( int i = 0; i < FRAME_HISTORY; i++ )
+        add_frame_times( &profiler, times );
+    get_frame_stats( &profiler, FRAME_PRESENT, &stats );
+    CU_ASSERT_DOUBLE_EQUAL( stats.p99, 0.5, 1e-9 );
+    CU_ASSERT_EQUAL( profiler.frames, 100 + FRAME_HISTORY );
+    // Test case 2: the measured phases add up to the frame
+    begin_frame( &profiler );
+    for ( volatile int i = 0; i < 100000; i++ );
+    end_frame_phase( &profiler, FRAME_BOARD );
+    end_frame_phase( &profiler, FRAME_PRESENT );
+    end_frame( &profiler );
+    double *last = profiler.times[( profiler.frames - 1 ) % FRAME_HISTORY];
+    CU_ASSERT_TRUE( last[FRAME_BOARD] > 0 );
+    CU_ASSERT_DOUBLE_EQUAL( last[FRAME_BOARD] + last[FRAME_PRESENT], last[FRAME_TOTAL], 1e-6 );
+    free_frame_profiler( &profiler );
+    // Test case 3: every frame is written to the CSV file after a header
+    CU_ASSERT_EQUAL( init_frame_profiler( &profiler, "no_such_directory/frames.csv" ), EXIT_FAILURE );
+    CU_ASSERT_EQUAL( init_frame_profiler( &profiler, "test_frames.csv" ), EXIT_SUCCESS );
+    for ( int i = 0; i < 3; i++ )
+        add_frame_times( &profiler, times );
+    free_frame_profiler( &profiler );
+    FILE *file = fopen( "test_frames.csv", "r" );
+    CU_ASSERT_PTR_NOT_NULL_FATAL( file );
+    char line[256];
+    int lines = 0;
+    CU_ASSERT_PTR_NOT_NULL( fgets( line, sizeof( line ), file ) );
+    CU_ASSERT_EQUAL( strncmp( line, "frame,events_ms,snapshot_ms", 27 ), 0 );
+    while ( fgets( line, sizeof( line ), file ) != NULL )
+        lines++;
+    CU_ASSERT_EQUAL( lines, 3 );
+    CU_ASSERT_EQUAL( strncmp( line, "2,0.0000,", 9 ), 0 );
+    fclose( file );
+    remove( "test_frames.csv" );
+}
+
 
 /** Tool functions for the testing **/
 // This is the tool function for creating a new board (for testing suites only!)
@@ -279,10 +1416,12 @@ static Board *tool_create_board( void )
     Board *b = ( Board * )malloc( sizeof( Board ) );
     b->rows = 10;
     b->columns = 10;
-    b->grid = ( int** )malloc( b->rows * sizeof( int* ) );
+    b->rule = RULE_CONWAY;
+    b->boundary = BOUNDARY_DEAD;
+    b->grid = ( Cell** )malloc( b->rows * sizeof( Cell* ) );
     for ( int i = 0; i < b->rows; i++ )
     {
-        b->grid[i] = ( int* )malloc( b->columns * sizeof( int ) );
+        b->grid[i] = ( Cell* )malloc( b->columns * sizeof( Cell ) );
         for ( int j = 0; j < b->columns; j++ )
         {
             b->grid[i][j] = 1;
@@ -291,6 +1430,49 @@ static Board *tool_create_board( void )
     return b;
 }
 
+// This is the tool function for creating a board filled with random cells (for testing suites only!)
+static Board *tool_create_random_board( int rows, int columns, unsigned int seed )
+{
+    Board *b = ( Board * )malloc( sizeof( Board ) );
+    b->rows = rows;
+    b->columns = columns;
+    b->rule = RULE_CONWAY;
+    b->boundary = BOUNDARY_DEAD;
+    b->grid = ( Cell** )malloc( b->rows * sizeof( Cell* ) );
+    srand( seed );
+    for ( int i = 0; i < b->rows; i++ )
+    {
+        b->grid[i] = ( Cell* )malloc( b->columns * sizeof( Cell ) );
+        for ( int j = 0; j < b->columns; j++ )
+        {
+            b->grid[i][j] = rand() % 3 == 0;
+        }
+    }
+    return b;
+}
+
+// This is the tool function for stepping a board with count_neighbors (for testing suites only!)
+static void tool_step_reference( Board *b )
+{
+    Cell *next = ( Cell* )malloc( b->rows * b->columns * sizeof( Cell ) );
+    for ( int i = 0; i < b->rows; i++ )
+    {
+        for ( int j = 0; j < b->columns; j++ )
+        {
+            int count = count_neighbors( b, i, j );
+            next[i * b->columns + j] = count == 3 || ( count == 2 && b->grid[i][j] );
+        }
+    }
+    for ( int i = 0; i < b->rows; i++ )
+    {
+        for ( int j = 0; j < b->columns; j++ )
+        {
+            b->grid[i][j] = next[i * b->columns + j];
+        }
+    }
+    free( next );
+}
+
 static int suite_init( void )
 {
     return 0;
@@ -350,6 +1532,101 @@ int main( void )
         CU_cleanup_registry();
         return CU_get_error();
     }
+    if ( ( NULL == CU_add_test( pSuite, "test_update_next_generation_bitboard", test_update_next_generation_bitboard ) ) ) 
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+    if ( ( NULL == CU_add_test( pSuite, "test_update_next_generation", test_update_next_generation ) ) ) 
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+    if ( ( NULL == CU_add_test( pSuite, "test_parallel_engine", test_parallel_engine ) ) ) 
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+    if ( ( NULL == CU_add_test( pSuite, "test_update_next_generation_simd", test_update_next_generation_simd ) ) ) 
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+    if ( ( NULL == CU_add_test( pSuite, "test_step_hashlife", test_step_hashlife ) ) ) 
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+    if ( ( NULL == CU_add_test( pSuite, "test_update_next_generation_tiled", test_update_next_generation_tiled ) ) ) 
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+    if ( ( NULL == CU_add_test( pSuite, "test_update_next_generation_sparse", test_update_next_generation_sparse ) ) ) 
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+    if ( ( NULL == CU_add_test( pSuite, "test_update_next_generation_tracked", test_update_next_generation_tracked ) ) ) 
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+    if ( ( NULL == CU_add_test( pSuite, "test_simulation", test_simulation ) ) ) 
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+    if ( ( NULL == CU_add_test( pSuite, "test_simulation_turbo", test_simulation_turbo ) ) ) 
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+    if ( ( NULL == CU_add_test( pSuite, "test_bin_file", test_bin_file ) ) ) 
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+    if ( ( NULL == CU_add_test( pSuite, "test_pattern_file", test_pattern_file ) ) ) 
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+    if ( ( NULL == CU_add_test( pSuite, "test_read_data_file", test_read_data_file ) ) ) 
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+    if ( ( NULL == CU_add_test( pSuite, "test_autosave", test_autosave ) ) ) 
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+    if ( ( NULL == CU_add_test( pSuite, "test_cycle_detector", test_cycle_detector ) ) ) 
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+    if ( ( NULL == CU_add_test( pSuite, "test_rules", test_rules ) ) ) 
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+    if ( ( NULL == CU_add_test( pSuite, "test_update_next_generation_lookup", test_update_next_generation_lookup ) ) ) 
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+    if ( ( NULL == CU_add_test( pSuite, "test_boundary_modes", test_boundary_modes ) ) ) 
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+    if ( ( NULL == CU_add_test( pSuite, "test_frame_profiler", test_frame_profiler ) ) ) 
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
 
     // Run all tests using the CUnit Basic interface
     CU_basic_set_mode( CU_BRM_VERBOSE );
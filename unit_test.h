@@ -31,5 +31,25 @@
 */
 static Board *tool_create_board( void );
 
+/* The tool function for creating a board filled with random cells
+    *
+    * @param rows: the number of rows in the board
+    * @param columns: the number of columns in the board
+    * @param seed: the seed of the random cells
+    *
+    * @return: a pointer to the created board
+    * 
+*/
+static Board *tool_create_random_board( int rows, int columns, unsigned int seed );
+
+/* The tool function for stepping a board to the next generation with count_neighbors
+    *
+    * @param b: the board to be stepped
+    *
+    * @return: none
+    * 
+*/
+static void tool_step_reference( Board *b );
+
 
 #endif
\ No newline at end of file